@@ -1,5 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include "pool.h"
+#include "out.h"
 
 typedef struct Node {
     int key;
@@ -54,6 +56,34 @@ Node* insert(Node* root, int key) {
 }
 */
 
+// Creates a new node from a pool (see pool.h)
+// Complexity: O(1)
+Node* newNodePooled(NodePool* pool, int key) {
+    Node* node = (Node*)poolAlloc(pool);
+    if (!node) return NULL;
+    node->key = key;
+    node->p = node->left = node->right = NULL;
+    return node;
+}
+
+// Inserts a key into the BST, allocating from pool
+// Average Complexity: O(log n), Worst-case: O(n)
+Node* insertPooled(NodePool* pool, Node* root, int key) {
+    if (!root) return newNodePooled(pool, key);
+    if (key < root->key) root->left = insertPooled(pool, root->left, key);
+    else if (key > root->key) root->right = insertPooled(pool, root->right, key);
+    return root;
+}
+
+// Returns every node of a pooled tree to its pool
+// Complexity: O(n), or O(1) with poolReset(pool) if the pool holds only this tree
+void freeTreePooled(NodePool* pool, Node* root) {
+    if (!root) return;
+    freeTreePooled(pool, root->left);
+    freeTreePooled(pool, root->right);
+    poolFree(pool, root);
+}
+
 // Insert a node into binary tree (Level Order)
 // Complexity: O(n)
 Node* insertLevelOrder(Node* root, int key) {
@@ -204,29 +234,47 @@ int size(Node* root) {
 
 // Traverses the BST in inorder
 // Complexity: O(n)
-void inorder(Node* root) {
+static void inorderOut(Node* root) {
     if (!root) return;
-    inorder(root->left);
-    printf("%d ", root->key);
-    inorder(root->right);
+    inorderOut(root->left);
+    outInt(root->key);
+    outStr(" ");
+    inorderOut(root->right);
+}
+
+void inorder(Node* root) {
+    inorderOut(root);
+    outFlush();
 }
 
 // Traverses the BST in preorder
 // Complexity: O(n)
-void preorder(Node* root) {
+static void preorderOut(Node* root) {
     if (!root) return;
-    printf("%d ", root->key);
-    preorder(root->left);
-    preorder(root->right);
+    outInt(root->key);
+    outStr(" ");
+    preorderOut(root->left);
+    preorderOut(root->right);
+}
+
+void preorder(Node* root) {
+    preorderOut(root);
+    outFlush();
 }
 
 // Traverses the BST in postorder
 // Complexity: O(n)
-void postorder(Node* root) {
+static void postorderOut(Node* root) {
     if (!root) return;
-    postorder(root->left);
-    postorder(root->right);
-    printf("%d ", root->key);
+    postorderOut(root->left);
+    postorderOut(root->right);
+    outInt(root->key);
+    outStr(" ");
+}
+
+void postorder(Node* root) {
+    postorderOut(root);
+    outFlush();
 }
 
 // BST to Inorder Array
@@ -475,10 +523,12 @@ void levelOrder(Node* root) {
 
     while (front < rear) {
         Node* curr = queue[front++];
-        printf("%d ", curr->key);
+        outInt(curr->key);
+        outStr(" ");
         if (curr->left) queue[rear++] = curr->left;
         if (curr->right) queue[rear++] = curr->right;
     }
+    outFlush();
     free(queue);
 }
 
@@ -647,7 +697,8 @@ void dfs(Node* root) {
     
     while (top >= 0) {
         Node* current = stack[top--];
-        printf("%d ", current->key);
+        outInt(current->key);
+        outStr(" ");
         
         // Push right child first so that left is processed first
         if (current->right)
@@ -661,6 +712,7 @@ void dfs(Node* root) {
             stack = realloc(stack, capacity * sizeof(Node*));
         }
     }
+    outFlush();
     free(stack);
 }
 
@@ -698,9 +750,11 @@ void printPathsUtil(Node* root, int path[], int pathLen) {
     // If it's a leaf, print the path
     if (!root->left && !root->right) {
         for (int i = 0; i < pathLen; i++) {
-            printf("%d ", path[i]);
+            outInt(path[i]);
+            outStr(" ");
         }
-        printf("\n");
+        outStr("\n");
+        outFlush();
     } else {
         printPathsUtil(root->left, path, pathLen);
         printPathsUtil(root->right, path, pathLen);
@@ -863,9 +917,12 @@ void pathSumUtil(Node* root, int sum, int path[], int pathLen) {
     path[pathLen++] = root->key;
     sum -= root->key;
     if (!root->left && !root->right && sum == 0) {
-        for (int i = 0; i < pathLen; i++)
-            printf("%d ", path[i]);
-        printf("\n");
+        for (int i = 0; i < pathLen; i++) {
+            outInt(path[i]);
+            outStr(" ");
+        }
+        outStr("\n");
+        outFlush();
     } else {
         pathSumUtil(root->left, sum, path, pathLen);
         pathSumUtil(root->right, sum, path, pathLen);
@@ -883,9 +940,12 @@ void printPaths(Node* root, int path[], int pathLen) {
     if (!root) return;
     path[pathLen++] = root->key;
     if (!root->left && !root->right) {
-        for (int i = 0; i < pathLen; i++)
-            printf("%d ", path[i]);
-        printf("\n");
+        for (int i = 0; i < pathLen; i++) {
+            outInt(path[i]);
+            outStr(" ");
+        }
+        outStr("\n");
+        outFlush();
     } else {
         printPaths(root->left, path, pathLen);
         printPaths(root->right, path, pathLen);
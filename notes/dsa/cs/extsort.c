@@ -0,0 +1,248 @@
+#include "basics.c"
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+// --- External Merge Sort ---
+// Sorts a binary file of native-endian int32 that is larger than RAM.
+// Pass 1 reads memory-sized chunks, sorts each with introSort and spills it to
+// a temp run; a chunk that continues the previous run in order is appended to
+// it, so sorted input ends up as one run that is just renamed to the output.
+// Pass 2 k-way merges the runs through a loser tree with large sequential
+// buffers, in several passes if there are too many runs for the budget.
+//
+// Usage: extsort <input> <output> [memory MiB = 1024] [temp dir = /tmp]
+
+#define EXT_MIN_BUF (1 << 20)  // smallest per-run merge buffer, in bytes
+
+typedef struct {
+    int fd;
+    int *buf;
+    size_t cap, pos, len;  // in ints
+} IntReader;
+
+typedef struct {
+    char **paths;
+    int count, cap;
+} RunList;
+
+// read()/write() until done; returns bytes moved or -1.
+static ssize_t readFull(int fd, void *buf, size_t bytes) {
+    size_t done = 0;
+    while (done < bytes) {
+        ssize_t r = read(fd, (char*)buf + done, bytes - done);
+        if (r < 0 && errno == EINTR) continue;
+        if (r < 0) return -1;
+        if (r == 0) break;
+        done += r;
+    }
+    return done;
+}
+
+static int writeFull(int fd, const void *buf, size_t bytes) {
+    size_t done = 0;
+    while (done < bytes) {
+        ssize_t w = write(fd, (const char*)buf + done, bytes - done);
+        if (w < 0 && errno == EINTR) continue;
+        if (w < 0) return -1;
+        done += w;
+    }
+    return 0;
+}
+
+static int refill(IntReader *r) {
+    ssize_t got = readFull(r->fd, r->buf, r->cap * sizeof(int));
+    if (got < 0) return -1;
+    r->pos = 0;
+    r->len = got / sizeof(int);
+    return 0;
+}
+
+static int newRun(RunList *runs, const char *tmpDir) {
+    if (runs->count == runs->cap) {
+        int cap = runs->cap ? 2 * runs->cap : 16;
+        char **p = (char**)realloc(runs->paths, cap * sizeof(char*));
+        if (!p) return -1;
+        runs->paths = p;
+        runs->cap = cap;
+    }
+    size_t len = strlen(tmpDir) + sizeof("/extsort-XXXXXX");
+    char *path = (char*)malloc(len);
+    if (!path) return -1;
+    snprintf(path, len, "%s/extsort-XXXXXX", tmpDir);
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        perror(path);
+        free(path);
+        return -1;
+    }
+    runs->paths[runs->count++] = path;
+    return fd;
+}
+
+static void freeRuns(RunList *runs) {
+    for (int i = 0; i < runs->count; i++) {
+        unlink(runs->paths[i]);
+        free(runs->paths[i]);
+    }
+    free(runs->paths);
+    runs->paths = NULL;
+    runs->count = runs->cap = 0;
+}
+
+static int isSorted(const int arr[], size_t n) {
+    for (size_t i = 1; i < n; i++)
+        if (arr[i - 1] > arr[i]) return 0;
+    return 1;
+}
+
+// Pass 1: cut the input into sorted runs of up to memBytes each.
+static int makeRuns(int in, size_t memBytes, const char *tmpDir, RunList *runs) {
+    size_t cap = memBytes / sizeof(int);
+    if (cap > INT_MAX) cap = INT_MAX;
+    int *mem = (int*)malloc(cap * sizeof(int));
+    if (!mem) return -1;
+    posix_fadvise(in, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    int fd = -1, last = 0, status = 0;
+    ssize_t got;
+    while ((got = readFull(in, mem, cap * sizeof(int))) > 0) {
+        size_t n = got / sizeof(int);
+        if (n == 0) break;
+        if (!isSorted(mem, n)) introSort(mem, 0, (int)n - 1);
+        if (fd < 0 || mem[0] < last) {
+            if (fd >= 0) close(fd);
+            if ((fd = newRun(runs, tmpDir)) < 0) {
+                status = -1;
+                break;
+            }
+        }
+        if (writeFull(fd, mem, n * sizeof(int)) < 0) {
+            perror("write run");
+            status = -1;
+            break;
+        }
+        last = mem[n - 1];
+    }
+    if (got < 0) {
+        perror("read input");
+        status = -1;
+    }
+    if (fd >= 0) close(fd);
+    free(mem);
+    return status;
+}
+
+// Loser tree over k readers: tree[0] is the winner, tree[1..k) hold losers.
+// Index k is a sentinel smaller than everything, used only while building.
+static long long ltKey(const IntReader r[], int k, int i) {
+    if (i == k) return LLONG_MIN;
+    return r[i].pos < r[i].len ? r[i].buf[r[i].pos] : LLONG_MAX;
+}
+
+static int ltBeats(const IntReader r[], int k, int a, int b) {
+    long long ka = ltKey(r, k, a), kb = ltKey(r, k, b);
+    return ka < kb || (ka == kb && a < b);
+}
+
+static void ltAdjust(int tree[], const IntReader r[], int k, int s) {
+    for (int t = (s + k) / 2; t > 0; t /= 2)
+        if (ltBeats(r, k, tree[t], s)) {
+            int x = tree[t]; tree[t] = s; s = x;
+        }
+    tree[0] = s;
+}
+
+// Merges run files [first, first + k) into outFd.
+static int mergeRuns(RunList *runs, int first, int k, int outFd, size_t memBytes) {
+    size_t bufInts = memBytes / (k + 1) / sizeof(int);
+    IntReader *r = (IntReader*)calloc(k, sizeof(IntReader));
+    int *tree = (int*)malloc(k * sizeof(int));
+    int *out = (int*)malloc(bufInts * sizeof(int));
+    int status = (r && tree && out) ? 0 : -1;
+    for (int i = 0; r && i < k; i++) r[i].fd = -1;
+    for (int i = 0; i < k && status == 0; i++) {
+        r[i].cap = bufInts;
+        r[i].buf = (int*)malloc(bufInts * sizeof(int));
+        r[i].fd = open(runs->paths[first + i], O_RDONLY);
+        if (!r[i].buf || r[i].fd < 0 || refill(&r[i]) < 0) status = -1;
+        else posix_fadvise(r[i].fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+
+    if (status == 0) {
+        for (int i = 0; i < k; i++) tree[i] = k;
+        for (int i = k - 1; i >= 0; i--) ltAdjust(tree, r, k, i);
+        size_t n = 0;
+        for (;;) {
+            int w = tree[0];
+            if (r[w].pos == r[w].len) break;
+            out[n++] = r[w].buf[r[w].pos++];
+            if (n == bufInts) {
+                if (writeFull(outFd, out, n * sizeof(int)) < 0) { status = -1; break; }
+                n = 0;
+            }
+            if (r[w].pos == r[w].len && refill(&r[w]) < 0) { status = -1; break; }
+            ltAdjust(tree, r, k, w);
+        }
+        if (status == 0 && writeFull(outFd, out, n * sizeof(int)) < 0) status = -1;
+    }
+    if (status < 0) perror("merge");
+
+    for (int i = 0; r && i < k; i++) {
+        if (r[i].fd >= 0) close(r[i].fd);
+        free(r[i].buf);
+    }
+    free(r); free(tree); free(out);
+    return status;
+}
+
+int externalSort(const char *inPath, const char *outPath, size_t memBytes, const char *tmpDir) {
+    if (memBytes < 4 * EXT_MIN_BUF) memBytes = 4 * EXT_MIN_BUF;
+    int in = open(inPath, O_RDONLY);
+    if (in < 0) {
+        perror(inPath);
+        return -1;
+    }
+    RunList runs = {0};
+    int status = makeRuns(in, memBytes, tmpDir, &runs);
+    close(in);
+
+    // Too many runs for one merge: fold groups of fanIn into longer runs.
+    int fanIn = (int)(memBytes / EXT_MIN_BUF) - 1, first = 0;
+    while (status == 0 && runs.count - first > fanIn) {
+        int fd = newRun(&runs, tmpDir);
+        if (fd < 0 || mergeRuns(&runs, first, fanIn, fd, memBytes) < 0) status = -1;
+        if (fd >= 0) close(fd);
+        for (int i = first; i < first + fanIn; i++) unlink(runs.paths[i]);
+        first += fanIn;
+    }
+
+    if (status == 0 && runs.count - first == 1 && chmod(runs.paths[first], 0644) == 0 &&
+        rename(runs.paths[first], outPath) == 0) {
+        freeRuns(&runs);
+        return 0;
+    }
+    if (status == 0) {
+        int out = open(outPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (out < 0) {
+            perror(outPath);
+            status = -1;
+        } else {
+            if (runs.count > first) status = mergeRuns(&runs, first, runs.count - first, out, memBytes);
+            if (close(out) < 0) status = -1;
+        }
+    }
+    freeRuns(&runs);
+    return status;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <input> <output> [memory MiB] [temp dir]\n", argv[0]);
+        return 2;
+    }
+    size_t mem = (size_t)(argc > 3 ? atol(argv[3]) : 1024) << 20;
+    const char *tmpDir = argc > 4 ? argv[4] : "/tmp";
+    return externalSort(argv[1], argv[2], mem, tmpDir) == 0 ? 0 : 1;
+}
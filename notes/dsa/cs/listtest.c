@@ -0,0 +1,152 @@
+#include "soa-ll.c"
+#include "ll.c"
+
+// --- List Test ---
+// Runs the soa-ll.c list operations on lists of every length from 0 to
+// MAX_N and checks each result against the same operation done on a plain
+// array. After every case the list is freed, and the test checks that each
+// slot the pool handed out is back on the free stack, so a node dropped
+// from a list shows up as a leak. ll.c's reorderList gets the same length
+// sweep, and its sorts get SORT_N-node lists that are sorted, reversed and
+// random; a sort that recurses once per node overflows the stack there.
+// Prints the failing cases and exits non-zero if there are any.
+//
+// Build: gcc -O2 listtest.c -o listtest
+// Usage: listtest
+#define MAX_N 64
+#define SORT_N (1 << 20)
+
+static int failed;
+
+static void check(const IdxPool* pool, Idx head, const int expect[], uint32_t n,
+                  const char* op, uint32_t size) {
+    int got[MAX_N + 1];
+    uint32_t len = listToArray(pool, head, got, MAX_N + 1);
+    if (len != n || memcmp(got, expect, n * sizeof(int)) != 0 || idxHasCycle(pool, head)) {
+        printf("FAIL  %-12s n=%-3u got ", op, size);
+        printIdxList(pool, head);
+        failed++;
+    }
+}
+
+// Every slot handed out must be free again once all lists are gone. Slots
+// already reported are not counted again.
+static void checkNoLeak(const IdxPool* pool, const char* op, uint32_t size) {
+    static uint32_t leaked;
+    uint32_t freeSlots = 0;
+    for (Idx i = pool->freeTop; i != IDX_NIL && freeSlots <= pool->used; i = pool->next[i])
+        freeSlots++;
+    if (freeSlots + leaked != pool->used) {
+        printf("FAIL  %-12s n=%-3u leaked %u slots\n", op, size, pool->used - freeSlots - leaked);
+        leaked = pool->used - freeSlots;
+        failed++;
+    }
+}
+
+static int compareInts(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+// Links nodes[0..n) in order, holding values[0..n)
+static Node* linkNodes(Node nodes[], const int values[], int n) {
+    for (int i = 0; i < n; i++) {
+        nodes[i].data = values[i];
+        nodes[i].next = (i + 1 < n) ? &nodes[i + 1] : NULL;
+    }
+    return n ? &nodes[0] : NULL;
+}
+
+static void checkNodes(Node* head, const int expect[], int n, const char* op, int size) {
+    int count = 0;
+    for (; head && count < n && head->data == expect[count]; head = head->next) count++;
+    if (count != n || head) {
+        printf("FAIL  %-12s n=%-7d wrong at position %d\n", op, size, count);
+        failed++;
+    }
+}
+
+static void testNodeLists(void) {
+    Node* nodes = (Node*)malloc(SORT_N * sizeof(Node));
+    int *values = (int*)malloc(SORT_N * sizeof(int)), *expect = (int*)malloc(SORT_N * sizeof(int));
+    if (!nodes || !values || !expect) {
+        fprintf(stderr, "out of memory\n");
+        failed++;
+        goto done;
+    }
+
+    for (int n = 0; n <= MAX_N; n++) {
+        for (int i = 0; i < n; i++) values[i] = i;
+        Node* head = linkNodes(nodes, values, n);
+        reorderList(head);
+        for (int i = 0, lo = 0, hi = n; i < n; i++) expect[i] = values[i % 2 ? --hi : lo++];
+        checkNodes(head, expect, n, "reorderList", n);
+    }
+
+    static const char* shapes[] = {"sorted", "reversed", "random"};
+    unsigned rng = 2463534242u;
+    for (int shape = 0; shape < 3; shape++) {
+        for (int i = 0; i < SORT_N; i++) {
+            rng ^= rng << 13;
+            rng ^= rng >> 17;
+            rng ^= rng << 5;
+            values[i] = shape == 0 ? i : shape == 1 ? SORT_N - i : (int)(rng % SORT_N);
+        }
+        memcpy(expect, values, SORT_N * sizeof(int));
+        qsort(expect, SORT_N, sizeof(int), compareInts);
+        for (int sort = 0; sort < 2; sort++) {
+            char op[32];
+            snprintf(op, sizeof(op), "%s %s", sort ? "mergeSort" : "quickSort", shapes[shape]);
+            Node* head = linkNodes(nodes, values, SORT_N);
+            head = sort ? mergeSort(head) : quickSort(head);
+            checkNodes(head, expect, SORT_N, op, SORT_N);
+        }
+    }
+done:
+    free(nodes);
+    free(values);
+    free(expect);
+}
+
+int main(void) {
+    IdxPool* pool = createIdxPool(16);
+    if (!pool) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    int arr[MAX_N], expect[MAX_N];
+    for (uint32_t n = 0; n <= MAX_N; n++) {
+        for (uint32_t i = 0; i < n; i++) arr[i] = (int)i;
+
+        // L0 -> Ln-1 -> L1 -> Ln-2 -> ...
+        Idx head = listFromArray(pool, arr, n);
+        idxReorderList(pool, head);
+        for (uint32_t i = 0, lo = 0, hi = n; i < n; i++) expect[i] = arr[i % 2 ? --hi : lo++];
+        check(pool, head, expect, n, "reorder", n);
+        idxFreeList(pool, head);
+        checkNoLeak(pool, "reorder", n);
+
+        head = listFromArray(pool, arr, n);
+        head = idxReverse(pool, head);
+        for (uint32_t i = 0; i < n; i++) expect[i] = arr[n - 1 - i];
+        check(pool, head, expect, n, "reverse", n);
+        idxFreeList(pool, head);
+        checkNoLeak(pool, "reverse", n);
+
+        for (int k = 2; k <= 3; k++) {
+            head = listFromArray(pool, arr, n);
+            head = idxReverseK(pool, head, k);
+            for (uint32_t g = 0; g < n; g += k) {
+                uint32_t end = g + k < n ? g + k : n;
+                for (uint32_t i = g; i < end; i++) expect[i] = arr[g + end - 1 - i];
+            }
+            check(pool, head, expect, n, k == 2 ? "reverseK(2)" : "reverseK(3)", n);
+            idxFreeList(pool, head);
+            checkNoLeak(pool, "reverseK", n);
+        }
+    }
+    freeIdxPool(pool);
+    testNodeLists();
+    if (!failed) printf("PASS  all lengths 0..%d, sorts of %d nodes\n", MAX_N, SORT_N);
+    return failed != 0;
+}
@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include "pool.h"
+#include "out.h"
 
 // Basic node structure
 typedef struct Node {
@@ -17,6 +19,15 @@ Node* createNode(int value) {
     return new;
 }
 
+// Create a node from a pool (see pool.h) - O(1)
+Node* createNodePooled(NodePool* pool, int value) {
+    Node* new = (Node*)poolAlloc(pool);
+    if (!new) return NULL;
+    new->data = value;
+    new->next = NULL;
+    return new;
+}
+
 // Insert at beginning - O(1)
 Node* insertFront(Node* head, int value) {
     Node* new = createNode(value);
@@ -109,18 +120,23 @@ bool hasCycle(Node* head) {
     return false;
 }
 
-// Merge two sorted lists - O(n+m)
+// Merge two sorted lists - O(n+m), iterative so long lists can't overflow the stack
 Node* mergeSorted(Node* l1, Node* l2) {
-    if (!l1) return l2;
-    if (!l2) return l1;
+    Node dummy = {0, NULL};
+    Node* tail = &dummy;
 
-    if (l1->data <= l2->data) {
-        l1->next = mergeSorted(l1->next, l2);
-        return l1;
-    } else {
-        l2->next = mergeSorted(l1, l2->next);
-        return l2;
+    while (l1 && l2) {
+        if (l1->data <= l2->data) {
+            tail->next = l1;
+            l1 = l1->next;
+        } else {
+            tail->next = l2;
+            l2 = l2->next;
+        }
+        tail = tail->next;
     }
+    tail->next = l1 ? l1 : l2;
+    return dummy.next;
 }
 
 // Check if palindrome - O(n)
@@ -200,10 +216,12 @@ Node* getNthFromEnd(Node* head, int n) {
 // Utility functions
 void printList(Node* head) {
     while (head) {
-        printf("%d -> ", head->data);
+        outInt(head->data);
+        outStr(" -> ");
         head = head->next;
     }
-    printf("NULL\n");
+    outStr("NULL\n");
+    outFlush();
 }
 
 int getLength(Node* head) {
@@ -225,6 +243,17 @@ void freeList(Node* head) {
     }
 }
 
+// Return a pooled list's nodes to its pool - O(n)
+// If the pool holds nothing else, poolReset(pool) does the same in O(1).
+void freeListPooled(NodePool* pool, Node* head) {
+    Node* temp;
+    while (head) {
+        temp = head;
+        head = head->next;
+        poolFree(pool, temp);
+    }
+}
+
 // Rotate list by k positions - O(n)
 Node* rotateList(Node* head, int k) {
     if (!head || !head->next || k == 0) return head;
@@ -261,23 +290,114 @@ Node* swapPairs(Node* head) {
     return temp;
 }
 
+// Sort list bottom-up - O(n log n), stable, O(1) stack
+// bucket[i] is empty or holds a sorted run of 2^i nodes. Each node is
+// carried up like a binary counter increment, merging with every full
+// bucket on the way, so no midpoint is ever searched for. Older runs are
+// always the left operand of mergeSorted, which keeps equal keys in order.
+#define LIST_SORT_BUCKETS 64
+
+Node* listSort(Node* head) {
+    Node* bucket[LIST_SORT_BUCKETS] = {NULL};
+    int used = 0;
+
+    while (head) {
+        Node* run = head;
+        head = head->next;
+        run->next = NULL;
+
+        int i = 0;
+        while (i < used && bucket[i]) {
+            run = mergeSorted(bucket[i], run);
+            bucket[i++] = NULL;
+        }
+        bucket[i] = run;
+        if (i == used) used++;
+    }
+
+    Node* result = NULL;
+    for (int i = 0; i < used; i++) {
+        if (bucket[i]) result = mergeSorted(bucket[i], result);
+    }
+    return result;
+}
+
 // Sort list using merge sort - O(n log n)
 Node* mergeSort(Node* head) {
+    return listSort(head);
+}
+
+// Sort list by gathering into an array - O(n)
+// One walk copies (key, node) pairs into an array, a stable LSD radix sort
+// (3 passes of 11 bits) orders them, and one pass relinks the nodes, so the
+// two list walks are the only pointer chasing. Falls back to listSort()
+// when memory runs out.
+#define GATHER_BITS 11
+#define GATHER_BUCKETS (1 << GATHER_BITS)
+
+typedef struct {
+    unsigned key;  // data with the sign bit flipped, so negatives sort first
+    Node* node;
+} NodeKey;
+
+Node* listSortGather(Node* head) {
     if (!head || !head->next) return head;
 
-    // Find middle
-    Node *slow = head, *fast = head->next;
-    while (fast && fast->next) {
-        slow = slow->next;
-        fast = fast->next->next;
+    int n = 0, cap = 1024;
+    NodeKey* src = (NodeKey*)malloc(cap * sizeof(NodeKey));
+    unsigned cnt[3][GATHER_BUCKETS] = {{0}};
+    for (Node* cur = head; cur && src; cur = cur->next) {
+        if (n == cap) {
+            NodeKey* grown = (NodeKey*)realloc(src, 2 * (size_t)cap * sizeof(NodeKey));
+            if (!grown) {
+                free(src);
+                src = NULL;
+                break;
+            }
+            src = grown;
+            cap *= 2;
+        }
+        unsigned k = (unsigned)cur->data ^ 0x80000000u;
+        src[n].key = k;
+        src[n++].node = cur;
+        for (int p = 0; p < 3; p++) cnt[p][(k >> (p * GATHER_BITS)) & (GATHER_BUCKETS - 1)]++;
+    }
+    NodeKey* dst = src ? (NodeKey*)malloc(n * sizeof(NodeKey)) : NULL;
+    if (!dst) {
+        free(src);
+        return listSort(head);
+    }
+
+    NodeKey *a = src, *b = dst;
+    for (int p = 0; p < 3; p++) {
+        int shift = p * GATHER_BITS;
+        unsigned* c = cnt[p];
+        if (c[(a[0].key >> shift) & (GATHER_BUCKETS - 1)] == (unsigned)n) continue;
+        unsigned sum = 0;
+        for (int d = 0; d < GATHER_BUCKETS; d++) {
+            unsigned t = c[d];
+            c[d] = sum;
+            sum += t;
+        }
+        for (int i = 0; i < n; i++) b[c[(a[i].key >> shift) & (GATHER_BUCKETS - 1)]++] = a[i];
+        NodeKey* t = a; a = b; b = t;
     }
 
-    // Split list
-    Node* right = slow->next;
-    slow->next = NULL;
+    for (int i = 0; i < n - 1; i++) a[i].node->next = a[i + 1].node;
+    a[n - 1].node->next = NULL;
+    head = a[0].node;
+    free(src);
+    free(dst);
+    return head;
+}
+
+// listSort() for short lists, listSortGather() from LIST_GATHER_MIN nodes
+#define LIST_GATHER_MIN 512
 
-    // Recursively sort and merge
-    return mergeSorted(mergeSort(head), mergeSort(right));
+Node* listSortHybrid(Node* head) {
+    int n = 0;
+    for (Node* cur = head; cur && n < LIST_GATHER_MIN; cur = cur->next) n++;
+    return n < LIST_GATHER_MIN ? listSort(head) : listSortGather(head);
 }
 
 // Add two numbers represented by linked lists - O(n)
@@ -349,23 +469,22 @@ Node* partition(Node* head, int x) {
 void reorderList(Node* head) {
     if (!head || !head->next) return;
 
-    // Find middle
+    // Find middle; the first half keeps the extra node when n is odd
     Node *slow = head, *fast = head;
-    Node *prev = NULL;
-    while (fast && fast->next) {
+    while (fast->next && fast->next->next) {
         fast = fast->next->next;
-        prev = slow;
         slow = slow->next;
     }
-    prev->next = NULL;
+    Node* second = slow->next;
+    slow->next = NULL;
 
     // Reverse second half
     Node *l2 = NULL;
-    while (slow) {
-        Node* next = slow->next;
-        slow->next = l2;
-        l2 = slow;
-        slow = next;
+    while (second) {
+        Node* next = second->next;
+        second->next = l2;
+        l2 = second;
+        second = next;
     }
 
     // Merge lists
@@ -469,7 +588,8 @@ Node* getTail(Node* head) {
     return head;
 }
 
-Node* partition(Node* head, Node* end, Node** newHead, Node** newEnd) {
+// Partition around the last node; named apart from partition() above
+Node* partitionLast(Node* head, Node* end, Node** newHead, Node** newEnd) {
     Node* pivot = end;
     Node *prev = NULL, *curr = head, *tail = pivot;
 
@@ -497,7 +617,7 @@ Node* quickSortRecur(Node* head, Node* end) {
     if (!head || head == end) return head;
 
     Node *newHead = NULL, *newEnd = NULL;
-    Node* pivot = partition(head, end, &newHead, &newEnd);
+    Node* pivot = partitionLast(head, end, &newHead, &newEnd);
 
     if (newHead != pivot) {
         Node* tmp = newHead;
@@ -513,8 +633,10 @@ Node* quickSortRecur(Node* head, Node* end) {
     return newHead;
 }
 
+// quickSortRecur() goes one level deep per node, and O(n^2), on sorted
+// input, so quickSort() is routed to listSort() like mergeSort()
 Node* quickSort(Node* head) {
-    return quickSortRecur(head, getTail(head));
+    return listSort(head);
 }
 
 // Utility: Print list with cycle (safe) - O(n)
@@ -526,14 +648,166 @@ void printListSafe(Node* head) {
         // Check if node already visited
         for (int j = 0; j < i; j++) {
             if (visited[j] == head) {
-                printf(" -> [CYCLE]\n");
+                outStr(" -> [CYCLE]\n");
+                outFlush();
                 return;
             }
         }
 
         visited[i++] = head;
-        printf("%d -> ", head->data);
+        outInt(head->data);
+        outStr(" -> ");
         head = head->next;
     }
-    printf("NULL\n");
+    outStr("NULL\n");
+    outFlush();
+}
+
+// List handle: head, tail and size kept current by the list* functions, so
+// appends, length and tail lookups are O(1). head is an ordinary Node*
+// chain, so every function above still works on it; after changing the
+// chain through one of them, call listSync() to re-derive tail and size.
+typedef struct {
+    Node *head, *tail;
+    int size;
+} List;
+
+// Wrap an existing chain - O(n)
+List listFromNodes(Node* head) {
+    List list = {head, NULL, 0};
+    for (Node* cur = head; cur; cur = cur->next) {
+        list.tail = cur;
+        list.size++;
+    }
+    return list;
+}
+
+// Recompute tail and size after raw Node* edits - O(n)
+void listSync(List* list) {
+    *list = listFromNodes(list->head);
+}
+
+// Insert at beginning - O(1)
+bool listPushFront(List* list, int value) {
+    Node* new = createNode(value);
+    if (!new) return false;
+    new->next = list->head;
+    list->head = new;
+    if (!list->tail) list->tail = new;
+    list->size++;
+    return true;
+}
+
+// Insert at end - O(1)
+bool listPushBack(List* list, int value) {
+    Node* new = createNode(value);
+    if (!new) return false;
+    if (list->tail) list->tail->next = new;
+    else list->head = new;
+    list->tail = new;
+    list->size++;
+    return true;
+}
+
+// Remove the first node, storing its value in *value - O(1)
+bool listPopFront(List* list, int* value) {
+    Node* first = list->head;
+    if (!first) return false;
+    *value = first->data;
+    list->head = first->next;
+    if (!list->head) list->tail = NULL;
+    list->size--;
+    free(first);
+    return true;
+}
+
+// Insert at position (0..size) - O(position), O(1) at either end
+bool listInsertAt(List* list, int value, int position) {
+    if (position < 0 || position > list->size) return false;
+    if (position == 0) return listPushFront(list, value);
+    if (position == list->size) return listPushBack(list, value);
+
+    Node* current = list->head;
+    for (int i = 0; i < position - 1; i++) current = current->next;
+    Node* new = createNode(value);
+    if (!new) return false;
+    new->next = current->next;
+    current->next = new;
+    list->size++;
+    return true;
+}
+
+// Delete first occurrence of value - O(n)
+bool listDeleteValue(List* list, int value) {
+    Node dummy = {0, list->head};
+    Node* current = &dummy;
+    while (current->next && current->next->data != value) {
+        current = current->next;
+    }
+    if (!current->next) return false;
+
+    Node* temp = current->next;
+    current->next = temp->next;
+    if (temp == list->tail) list->tail = (current == &dummy) ? NULL : current;
+    list->head = dummy.next;
+    list->size--;
+    free(temp);
+    return true;
+}
+
+int listLength(const List* list) {
+    return list->size;
+}
+
+Node* listTail(const List* list) {
+    return list->tail;
+}
+
+// Get nth node from end (1-based) - one walk of size - n steps
+Node* listNthFromEnd(const List* list, int n) {
+    if (n < 1 || n > list->size) return NULL;
+    Node* current = list->head;
+    for (int i = 0; i < list->size - n; i++) current = current->next;
+    return current;
+}
+
+// Rotate right by k positions - one partial walk, no second pass
+void listRotate(List* list, int k) {
+    if (list->size < 2) return;
+    k %= list->size;
+    if (k < 0) k += list->size;
+    if (k == 0) return;
+
+    // The new tail sits size - k - 1 steps from the head.
+    Node* newTail = list->head;
+    for (int i = 0; i < list->size - k - 1; i++) newTail = newTail->next;
+    list->tail->next = list->head;
+    list->head = newTail->next;
+    newTail->next = NULL;
+    list->tail = newTail;
+}
+
+// Reverse list - O(n)
+void listReverse(List* list) {
+    list->tail = list->head;
+    list->head = reverse(list->head);
+}
+
+// Intersection point of two Y-shaped lists, using the cached lengths - O(n)
+Node* listIntersectionPoint(const List* a, const List* b) {
+    Node *p = a->head, *q = b->head;
+    for (int d = a->size - b->size; d > 0; d--) p = p->next;
+    for (int d = b->size - a->size; d > 0; d--) q = q->next;
+    while (p && p != q) {
+        p = p->next;
+        q = q->next;
+    }
+    return p;
+}
+
+// Free all nodes and reset the handle - O(n)
+void listClear(List* list) {
+    freeList(list->head);
+    list->head = list->tail = NULL;
+    list->size = 0;
 }
\ No newline at end of file
@@ -0,0 +1,273 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "out.h"
+
+// Lock-free sorted linked list set (Harris, with Michael's unlink-as-you-go
+// search). Shared between threads without a mutex:
+// - Remove first marks the low bit of the victim's next pointer (logical
+//   delete), then CASes it out of its predecessor (physical delete).
+// - Any traversal that meets a marked node unlinks it itself, so insert
+//   and remove never act on a node that is being deleted.
+// - contains() never writes.
+//
+// Unlinked nodes are not freed immediately, since another thread may still
+// be standing on one. They are reclaimed by epoch-based reclamation (EBR):
+// - Every operation runs inside an epoch announced in the calling thread's
+//   record.
+// - An unlinked node goes into a per-thread bag tagged with the global
+//   epoch.
+// - The bag is freed once the global epoch has moved two past that tag.
+//   By then every thread that could have seen the node has left its
+//   operation.
+//
+// Each thread calls lfRegister() once per list and passes the handle to
+// every call.
+//
+//   LFThread* th = lfRegister(list);
+//   lfInsert(list, th, 42); lfContains(list, th, 42); lfRemove(list, th, 42);
+//   lfUnregister(th);
+#define EBR_ADVANCE 64  // retirements between attempts to advance the epoch
+
+typedef struct LFNode {
+    int data;
+    _Atomic(uintptr_t) next;  // successor, low bit set once this node is deleted
+    struct LFNode* retiredNext;
+} LFNode;
+
+typedef struct LFThread {
+    struct LFThread* next;
+    _Atomic int inUse;
+    _Atomic unsigned long state;  // epoch << 1 | 1 inside an operation, else 0
+    unsigned long seen;           // last epoch this thread entered
+    LFNode* bag[3];               // retired nodes, indexed by epoch % 3
+    unsigned long bagEpoch[3];
+    unsigned long retired;
+    struct LFList* list;
+} LFThread;
+
+typedef struct LFList {
+    _Atomic(uintptr_t) head;
+    _Atomic unsigned long epoch;
+    _Atomic(LFThread*) threads;  // every record ever registered, never shrinks
+} LFList;
+
+#define MARK(p) ((p) | 1)
+#define IS_MARKED(p) ((p) & 1)
+#define PTR(p) ((LFNode*)((p) & ~(uintptr_t)1))
+
+LFList* createLFList(void) {
+    LFList* list = (LFList*)malloc(sizeof(LFList));
+    if (!list) return NULL;
+    atomic_init(&list->head, 0);
+    atomic_init(&list->epoch, 0);
+    atomic_init(&list->threads, NULL);
+    return list;
+}
+
+// Epoch-based reclamation
+
+// Claim an idle record or add a new one; NULL if out of memory
+LFThread* lfRegister(LFList* list) {
+    for (LFThread* t = atomic_load(&list->threads); t; t = t->next) {
+        int idle = 0;
+        if (atomic_compare_exchange_strong(&t->inUse, &idle, 1)) return t;
+    }
+    LFThread* t = (LFThread*)calloc(1, sizeof(LFThread));
+    if (!t) return NULL;
+    atomic_init(&t->inUse, 1);
+    atomic_init(&t->state, 0);
+    t->list = list;
+    t->next = atomic_load(&list->threads);
+    while (!atomic_compare_exchange_weak(&list->threads, &t->next, t));
+    return t;
+}
+
+// Release the record for reuse; its unreclaimed nodes stay in its bags
+void lfUnregister(LFThread* th) {
+    atomic_store(&th->state, 0);
+    atomic_store_explicit(&th->inUse, 0, memory_order_release);
+}
+
+static void freeChain(LFNode* node) {
+    while (node) {
+        LFNode* next = node->retiredNext;
+        free(node);
+        node = next;
+    }
+}
+
+static void epochEnter(LFThread* th) {
+    unsigned long e = atomic_load(&th->list->epoch);
+    atomic_store(&th->state, e << 1 | 1);
+    // Announce before touching any node, or a reclaimer could miss us.
+    atomic_thread_fence(memory_order_seq_cst);
+    if (e != th->seen) {
+        th->seen = e;
+        for (int i = 0; i < 3; i++) {
+            if (th->bag[i] && th->bagEpoch[i] + 2 <= e) {
+                freeChain(th->bag[i]);
+                th->bag[i] = NULL;
+            }
+        }
+    }
+}
+
+static void epochExit(LFThread* th) {
+    atomic_store_explicit(&th->state, 0, memory_order_release);
+}
+
+// Bump the global epoch if every thread inside an operation has seen it.
+static void tryAdvance(LFList* list) {
+    unsigned long e = atomic_load(&list->epoch);
+    for (LFThread* t = atomic_load(&list->threads); t; t = t->next) {
+        unsigned long s = atomic_load(&t->state);
+        if ((s & 1) && (s >> 1) != e) return;
+    }
+    atomic_compare_exchange_strong(&list->epoch, &e, e + 1);
+}
+
+// Called by the thread whose CAS unlinked node.
+static void retire(LFThread* th, LFNode* node) {
+    // The tag must be read after the unlink, so it is no older than any
+    // epoch a thread that can still reach node has announced.
+    atomic_thread_fence(memory_order_seq_cst);
+    unsigned long e = atomic_load(&th->list->epoch);
+    int i = e % 3;
+    if (th->bag[i] && th->bagEpoch[i] != e) {
+        // Left over from epoch e - 3 or earlier: already safe.
+        freeChain(th->bag[i]);
+        th->bag[i] = NULL;
+    }
+    node->retiredNext = th->bag[i];
+    th->bag[i] = node;
+    th->bagEpoch[i] = e;
+    if (++th->retired % EBR_ADVANCE == 0) tryAdvance(th->list);
+}
+
+// List operations
+
+// Find the first node with data >= value, unlinking marked nodes on the way.
+// *prevLink is the link that points to the returned node (NULL at the end).
+static LFNode* find(LFList* list, LFThread* th, int value, _Atomic(uintptr_t)** prevLink) {
+retry:;
+    _Atomic(uintptr_t)* prev = &list->head;
+    LFNode* cur = PTR(atomic_load_explicit(prev, memory_order_acquire));
+    while (cur) {
+        uintptr_t next = atomic_load_explicit(&cur->next, memory_order_acquire);
+        if (IS_MARKED(next)) {
+            uintptr_t expected = (uintptr_t)cur;
+            if (!atomic_compare_exchange_strong_explicit(prev, &expected, (uintptr_t)PTR(next),
+                                                         memory_order_acq_rel, memory_order_acquire))
+                goto retry;
+            retire(th, cur);
+            cur = PTR(next);
+            continue;
+        }
+        if (cur->data >= value) break;
+        prev = &cur->next;
+        cur = PTR(next);
+    }
+    *prevLink = prev;
+    return cur;
+}
+
+// Insert value; false if already present or out of memory
+bool lfInsert(LFList* list, LFThread* th, int value) {
+    LFNode* new = (LFNode*)malloc(sizeof(LFNode));
+    if (!new) return false;
+    new->data = value;
+    new->retiredNext = NULL;
+
+    epochEnter(th);
+    for (;;) {
+        _Atomic(uintptr_t)* prev;
+        LFNode* cur = find(list, th, value, &prev);
+        if (cur && cur->data == value) {
+            epochExit(th);
+            free(new);
+            return false;
+        }
+        atomic_store_explicit(&new->next, (uintptr_t)cur, memory_order_relaxed);
+        uintptr_t expected = (uintptr_t)cur;
+        if (atomic_compare_exchange_strong_explicit(prev, &expected, (uintptr_t)new,
+                                                    memory_order_release, memory_order_relaxed))
+            break;
+    }
+    epochExit(th);
+    return true;
+}
+
+// Remove value; false if not present
+bool lfRemove(LFList* list, LFThread* th, int value) {
+    epochEnter(th);
+    for (;;) {
+        _Atomic(uintptr_t)* prev;
+        LFNode* cur = find(list, th, value, &prev);
+        if (!cur || cur->data != value) {
+            epochExit(th);
+            return false;
+        }
+        uintptr_t next = atomic_load_explicit(&cur->next, memory_order_acquire);
+        if (IS_MARKED(next)) continue;  // someone else is removing it
+        // Marking is the linearization point.
+        if (!atomic_compare_exchange_strong_explicit(&cur->next, &next, MARK(next),
+                                                     memory_order_acq_rel, memory_order_relaxed))
+            continue;
+        uintptr_t expected = (uintptr_t)cur;
+        if (atomic_compare_exchange_strong_explicit(prev, &expected, next,
+                                                    memory_order_acq_rel, memory_order_relaxed))
+            retire(th, cur);
+        else
+            find(list, th, value, &prev);  // let a search unlink it
+        break;
+    }
+    epochExit(th);
+    return true;
+}
+
+// Read-only traversal: skips over marked nodes without unlinking them
+bool lfContains(LFList* list, LFThread* th, int value) {
+    epochEnter(th);
+    LFNode* cur = PTR(atomic_load_explicit(&list->head, memory_order_acquire));
+    while (cur && cur->data < value) {
+        cur = PTR(atomic_load_explicit(&cur->next, memory_order_acquire));
+    }
+    bool found = cur && cur->data == value &&
+                 !IS_MARKED(atomic_load_explicit(&cur->next, memory_order_acquire));
+    epochExit(th);
+    return found;
+}
+
+// Utility functions (not linearizable; meant for quiescent lists)
+void printLFList(LFList* list) {
+    for (uintptr_t p = atomic_load(&list->head); PTR(p); p = atomic_load(&PTR(p)->next)) {
+        if (!IS_MARKED(atomic_load(&PTR(p)->next))) {
+            outInt(PTR(p)->data);
+            outStr(" -> ");
+        }
+    }
+    outStr("NULL\n");
+    outFlush();
+}
+
+// Free the list, its records and all retired nodes; no thread may be using it
+void freeLFList(LFList* list) {
+    if (!list) return;
+    uintptr_t p = atomic_load(&list->head);
+    while (PTR(p)) {
+        LFNode* node = PTR(p);
+        p = atomic_load(&node->next);
+        free(node);
+    }
+    LFThread* t = atomic_load(&list->threads);
+    while (t) {
+        LFThread* next = t->next;
+        for (int i = 0; i < 3; i++) freeChain(t->bag[i]);
+        free(t);
+        t = next;
+    }
+    free(list);
+}
@@ -0,0 +1,255 @@
+#include "lockfree-ll.c"
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+// --- Lock-free List Stress Test ---
+// Hammers lockfree-ll.c from several threads and checks the result three
+// ways. Prints one line per check and exits non-zero if any fails.
+// - Model: STRESS_THREADS threads run a random mix of insert, remove and
+//   contains over STRESS_KEYS keys. Each thread re-registers now and then,
+//   so records get reused. Per key, the successful inserts minus the
+//   successful removes must be 0 or 1, and must match what contains()
+//   reports at the end. The list must be strictly ascending.
+// - Reclamation: every successful remove unlinks exactly one node, so the
+//   threads must have retired exactly that many nodes between them. The
+//   epoch must have moved, and the retire bags must have been emptied
+//   along the way, not just at freeLFList().
+// - Linearizability: many short rounds in which LIN_THREADS threads each
+//   run LIN_OPS random operations on two keys. Every operation is stamped
+//   before and after. A depth-first search looks for an order of the
+//   operations that respects those stamps and that a sequential set would
+//   answer the same way.
+//
+// Build: gcc -O2 -pthread lockfree-stress.c -o lockfree-stress
+//        gcc -O1 -g -fsanitize=thread -pthread lockfree-stress.c -o lockfree-stress-tsan
+//        gcc -O1 -g -fsanitize=address -pthread lockfree-stress.c -o lockfree-stress-asan
+// Usage: lockfree-stress [ops per thread]
+#define STRESS_THREADS 8
+#define STRESS_KEYS 256
+#define STRESS_OPS 300000
+#define LIN_THREADS 4
+#define LIN_OPS 6
+#define LIN_ROUNDS 3000
+
+enum { OP_INSERT, OP_REMOVE, OP_CONTAINS };
+
+typedef struct {
+    LFList* list;
+    int id, ops;
+} Worker;
+
+static _Atomic long inserted[STRESS_KEYS], removed[STRESS_KEYS];
+
+static unsigned nextRandom(unsigned* s) {
+    *s = *s * 1103515245u + 12345u;
+    return *s >> 8;
+}
+
+static void* stressWorker(void* arg) {
+    Worker* w = (Worker*)arg;
+    unsigned s = w->id * 2654435761u + 1;
+    LFThread* th = lfRegister(w->list);
+    for (int i = 0; i < w->ops && th; i++) {
+        unsigned r = nextRandom(&s);
+        int key = r % STRESS_KEYS, op = (r >> 12) % 10;
+        if (op < 2) {
+            if (lfInsert(w->list, th, key)) inserted[key]++;
+        } else if (op < 4) {
+            if (lfRemove(w->list, th, key)) removed[key]++;
+        } else {
+            lfContains(w->list, th, key);
+        }
+        if (i % 50000 == 49999) {
+            lfUnregister(th);
+            th = lfRegister(w->list);
+        }
+    }
+    if (th) lfUnregister(th);
+    return NULL;
+}
+
+static int startWorkers(pthread_t tid[], Worker w[], int threads, void* (*fn)(void*)) {
+    for (int i = 0; i < threads; i++) {
+        if (pthread_create(&tid[i], NULL, fn, &w[i]) != 0) {
+            fprintf(stderr, "pthread_create failed\n");
+            for (int j = 0; j < i; j++) pthread_join(tid[j], NULL);
+            return -1;
+        }
+    }
+    for (int i = 0; i < threads; i++) pthread_join(tid[i], NULL);
+    return 0;
+}
+
+static bool checkModel(LFList* list, long* removes) {
+    *removes = 0;
+    LFThread* th = lfRegister(list);
+    if (!th) return false;
+    bool ok = true;
+    for (int k = 0; k < STRESS_KEYS; k++) {
+        long present = inserted[k] - removed[k];
+        *removes += removed[k];
+        if ((present != 0 && present != 1) || lfContains(list, th, k) != present) {
+            printf("FAIL  key %d: %ld inserts, %ld removes, contains %d\n", k, inserted[k],
+                   removed[k], lfContains(list, th, k));
+            ok = false;
+        }
+    }
+    lfUnregister(th);
+
+    int prev = -1;
+    for (LFNode* n = PTR(atomic_load(&list->head)); n; n = PTR(atomic_load(&n->next))) {
+        if (n->data <= prev) {
+            printf("FAIL  list not ascending: %d after %d\n", n->data, prev);
+            return false;
+        }
+        prev = n->data;
+    }
+    return ok;
+}
+
+static bool checkReclamation(LFList* list, long removes) {
+    long retired = 0, waiting = 0;
+    for (LFThread* t = atomic_load(&list->threads); t; t = t->next) {
+        retired += t->retired;
+        for (int i = 0; i < 3; i++)
+            for (LFNode* n = t->bag[i]; n; n = n->retiredNext) waiting++;
+    }
+    unsigned long epoch = atomic_load(&list->epoch);
+    bool ok = retired == removes && epoch > 0 && waiting < retired;
+    printf("%s  reclamation: %ld removes, %ld retired, %ld freed, %ld waiting, epoch %lu\n",
+           ok ? "PASS" : "FAIL", removes, retired, retired - waiting, waiting, epoch);
+    return ok;
+}
+
+// Linearizability
+
+typedef struct {
+    int op, key, result;
+    long invoked, returned;
+} Event;
+
+typedef struct {
+    LFList* list;
+    unsigned seed;
+    Event events[LIN_OPS];
+} LinWorker;
+
+static _Atomic long linClock;
+static _Atomic int linGo;
+
+static void* linWorker(void* arg) {
+    LinWorker* w = (LinWorker*)arg;
+    LFThread* th = lfRegister(w->list);
+    if (!th) return NULL;
+    while (!atomic_load(&linGo)) sched_yield();
+    for (int i = 0; i < LIN_OPS; i++) {
+        Event* e = &w->events[i];
+        unsigned r = nextRandom(&w->seed);
+        e->key = r % 2;
+        e->op = (r >> 8) % 3;
+        e->invoked = linClock++;
+        e->result = e->op == OP_INSERT   ? lfInsert(w->list, th, e->key)
+                    : e->op == OP_REMOVE ? lfRemove(w->list, th, e->key)
+                                         : lfContains(w->list, th, e->key);
+        e->returned = linClock++;
+    }
+    lfUnregister(th);
+    return NULL;
+}
+
+// Wing & Gong: try every pending operation that could have taken effect
+// first (nothing pending returned before it was invoked) against the
+// sequential set, given as a bitmask of the two keys.
+static bool linearize(LinWorker w[], int done[], int set) {
+    long firstReturn = -1;
+    for (int t = 0; t < LIN_THREADS; t++) {
+        if (done[t] == LIN_OPS) continue;
+        long r = w[t].events[done[t]].returned;
+        if (firstReturn < 0 || r < firstReturn) firstReturn = r;
+    }
+    if (firstReturn < 0) return true;
+
+    for (int t = 0; t < LIN_THREADS; t++) {
+        if (done[t] == LIN_OPS) continue;
+        const Event* e = &w[t].events[done[t]];
+        if (e->invoked > firstReturn) continue;
+        int bit = 1 << e->key, present = (set & bit) != 0, next = set;
+        if (e->op == OP_INSERT) {
+            if (e->result != !present) continue;
+            next |= bit;
+        } else if (e->op == OP_REMOVE) {
+            if (e->result != present) continue;
+            next &= ~bit;
+        } else if (e->result != present) {
+            continue;
+        }
+        done[t]++;
+        bool ok = linearize(w, done, next);
+        done[t]--;
+        if (ok) return true;
+    }
+    return false;
+}
+
+static bool checkLinearizable(void) {
+    pthread_t tid[LIN_THREADS];
+    LinWorker w[LIN_THREADS];
+    for (int round = 0; round < LIN_ROUNDS; round++) {
+        LFList* list = createLFList();
+        if (!list) return false;
+        atomic_store(&linGo, 0);
+        for (int i = 0; i < LIN_THREADS; i++) {
+            w[i].list = list;
+            w[i].seed = (round * LIN_THREADS + i) * 2654435761u + 1;
+            memset(w[i].events, 0, sizeof(w[i].events));
+        }
+        int started = 0;
+        for (; started < LIN_THREADS; started++)
+            if (pthread_create(&tid[started], NULL, linWorker, &w[started]) != 0) break;
+        atomic_store(&linGo, 1);
+        for (int i = 0; i < started; i++) pthread_join(tid[i], NULL);
+        freeLFList(list);
+        if (started < LIN_THREADS) {
+            fprintf(stderr, "pthread_create failed\n");
+            return false;
+        }
+
+        int done[LIN_THREADS] = {0};
+        if (!linearize(w, done, 0)) {
+            printf("FAIL  linearizability: round %d has no valid order\n", round);
+            return false;
+        }
+    }
+    printf("PASS  linearizability: %d rounds of %d threads x %d ops\n", LIN_ROUNDS, LIN_THREADS,
+           LIN_OPS);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int ops = argc > 1 ? atoi(argv[1]) : STRESS_OPS;
+    LFList* list = createLFList();
+    if (!list || ops <= 0) {
+        fprintf(stderr, list ? "usage: lockfree-stress [ops per thread]\n" : "out of memory\n");
+        freeLFList(list);
+        return 1;
+    }
+
+    pthread_t tid[STRESS_THREADS];
+    Worker w[STRESS_THREADS];
+    for (int i = 0; i < STRESS_THREADS; i++) w[i] = (Worker){list, i, ops};
+    if (startWorkers(tid, w, STRESS_THREADS, stressWorker) != 0) {
+        freeLFList(list);
+        return 1;
+    }
+
+    long removes;
+    bool ok = checkModel(list, &removes);
+    printf("%s  model: %d threads x %d ops over %d keys\n", ok ? "PASS" : "FAIL", STRESS_THREADS,
+           ops, STRESS_KEYS);
+    ok &= checkReclamation(list, removes);
+    freeLFList(list);
+
+    ok &= checkLinearizable();
+    return !ok;
+}
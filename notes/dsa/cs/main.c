@@ -1,14 +1,31 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <limits.h>
+#include <time.h>
 
 // --- Sorting Algorithms ---
 
+// Comparison/swap counters used by sortbench.c. They compile away unless
+// SORT_STATS is defined. The SIMD network in sortSmall() is data-oblivious,
+// so it is counted as its comparator total plus n moves per call.
+#ifdef SORT_STATS
+long long sortCmps, sortSwaps;
+#define COUNT_CMP(e) (sortCmps++, (e))
+#define COUNT_SWAP(k) (sortSwaps += (k))
+#else
+#define COUNT_CMP(e) (e)
+#define COUNT_SWAP(k) ((void)0)
+#endif
+
 // Bubble Sort
 void bubbleSort(int arr[], int n) {
     for (int i = 0; i < n - 1; i++) {
         int swapped = 0;
         for (int j = 0; j < n - i - 1; j++) {
-            if (arr[j] > arr[j + 1]) {
+            if (COUNT_CMP(arr[j] > arr[j + 1])) {
+                COUNT_SWAP(1);
                 int temp = arr[j];
                 arr[j] = arr[j + 1];
                 arr[j + 1] = temp;
@@ -24,10 +41,11 @@ void selectionSort(int arr[], int n) {
     for (int i = 0; i < n - 1; i++) {
         int minIndex = i;
         for (int j = i + 1; j < n; j++) {
-            if (arr[j] < arr[minIndex])
+            if (COUNT_CMP(arr[j] < arr[minIndex]))
                 minIndex = j;
         }
         if (minIndex != i) {
+            COUNT_SWAP(1);
             int temp = arr[i];
             arr[i] = arr[minIndex];
             arr[minIndex] = temp;
@@ -40,7 +58,8 @@ void insertionSort(int arr[], int n) {
     for (int i = 1; i < n; i++) {
         int key = arr[i];
         int j = i - 1;
-        while (j >= 0 && arr[j] > key) {
+        while (j >= 0 && COUNT_CMP(arr[j] > key)) {
+            COUNT_SWAP(1);
             arr[j + 1] = arr[j];
             j--;
         }
@@ -48,22 +67,293 @@ void insertionSort(int arr[], int n) {
     }
 }
 
+// Sorting Network (SIMD leaf sort)
+// sortSmall() sorts up to SORTNET_MAX ints in registers: every vector is
+// sorted by an in-lane bitonic network, then vectors are bitonically merged.
+// AVX2 (8 lanes) or SSE4.1 (4 lanes) is chosen once from cpuid; anything
+// else falls back to insertionSort.
+#define SORTNET_MAX 32
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+
+// Lane i keeps max(v[i], p[i]) where takeMax is set, min otherwise.
+__attribute__((target("avx2")))
+static inline __m256i cmpSwap8(__m256i v, __m256i perm, __m256i takeMax) {
+    __m256i p = _mm256_permutevar8x32_epi32(v, perm);
+    return _mm256_blendv_epi8(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), takeMax);
+}
+
+// Sorts a bitonic vector ascending (half-cleaners at distance 4, 2, 1).
+__attribute__((target("avx2")))
+static inline __m256i cleanVec8(__m256i v) {
+    v = cmpSwap8(v, _mm256_setr_epi32(4, 5, 6, 7, 0, 1, 2, 3),
+                    _mm256_setr_epi32(0, 0, 0, 0, -1, -1, -1, -1));
+    v = cmpSwap8(v, _mm256_setr_epi32(2, 3, 0, 1, 6, 7, 4, 5),
+                    _mm256_setr_epi32(0, 0, -1, -1, 0, 0, -1, -1));
+    return cmpSwap8(v, _mm256_setr_epi32(1, 0, 3, 2, 5, 4, 7, 6),
+                       _mm256_setr_epi32(0, -1, 0, -1, 0, -1, 0, -1));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i sortVec8(__m256i v) {
+    v = cmpSwap8(v, _mm256_setr_epi32(1, 0, 3, 2, 5, 4, 7, 6),
+                    _mm256_setr_epi32(0, -1, -1, 0, 0, -1, -1, 0));
+    v = cmpSwap8(v, _mm256_setr_epi32(2, 3, 0, 1, 6, 7, 4, 5),
+                    _mm256_setr_epi32(0, 0, -1, -1, -1, -1, 0, 0));
+    v = cmpSwap8(v, _mm256_setr_epi32(1, 0, 3, 2, 5, 4, 7, 6),
+                    _mm256_setr_epi32(0, -1, 0, -1, -1, 0, -1, 0));
+    return cleanVec8(v);
+}
+
+// Merges sorted vectors into one sorted run of nv (a power of two) vectors:
+// reverse the upper run, then half-clean across vectors and within lanes.
+__attribute__((target("avx2")))
+static void mergeVecs8(__m256i v[], int nv) {
+    const __m256i rev = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    for (int w = 1; w < nv; w *= 2) {
+        for (int b = 0; b < nv; b += 2 * w) {
+            for (int t = 0; t < w / 2; t++) {
+                __m256i x = v[b + w + t];
+                v[b + w + t] = v[b + 2 * w - 1 - t];
+                v[b + 2 * w - 1 - t] = x;
+            }
+            for (int t = b + w; t < b + 2 * w; t++)
+                v[t] = _mm256_permutevar8x32_epi32(v[t], rev);
+            for (int d = w; d >= 1; d /= 2)
+                for (int i = b; i < b + 2 * w; i++)
+                    if (!((i - b) & d)) {
+                        __m256i lo = _mm256_min_epi32(v[i], v[i + d]);
+                        v[i + d] = _mm256_max_epi32(v[i], v[i + d]);
+                        v[i] = lo;
+                    }
+            for (int i = b; i < b + 2 * w; i++) v[i] = cleanVec8(v[i]);
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+static void sortNetAVX2(int arr[], int n) {
+    int buf[SORTNET_MAX];
+    __m256i v[SORTNET_MAX / 8];
+    int nv = 1;
+    while (nv * 8 < n) nv *= 2;
+    for (int i = 0; i < nv * 8; i++) buf[i] = (i < n) ? arr[i] : INT_MAX;
+    for (int i = 0; i < nv; i++)
+        v[i] = sortVec8(_mm256_loadu_si256((const __m256i*)(buf + 8 * i)));
+    mergeVecs8(v, nv);
+    for (int i = 0; i < nv; i++) _mm256_storeu_si256((__m256i*)(buf + 8 * i), v[i]);
+    memcpy(arr, buf, n * sizeof(int));
+}
+
+// SSE4.1 version of the same network with 4 lanes per vector.
+__attribute__((target("sse4.1")))
+static inline __m128i cmpSwap4(__m128i v, __m128i p, __m128i takeMax) {
+    return _mm_blendv_epi8(_mm_min_epi32(v, p), _mm_max_epi32(v, p), takeMax);
+}
+
+__attribute__((target("sse4.1")))
+static inline __m128i cleanVec4(__m128i v) {
+    v = cmpSwap4(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)), _mm_setr_epi32(0, 0, -1, -1));
+    return cmpSwap4(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_epi32(0, -1, 0, -1));
+}
+
+__attribute__((target("sse4.1")))
+static inline __m128i sortVec4(__m128i v) {
+    v = cmpSwap4(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_epi32(0, -1, -1, 0));
+    return cleanVec4(v);
+}
+
+__attribute__((target("sse4.1")))
+static void mergeVecs4(__m128i v[], int nv) {
+    for (int w = 1; w < nv; w *= 2) {
+        for (int b = 0; b < nv; b += 2 * w) {
+            for (int t = 0; t < w / 2; t++) {
+                __m128i x = v[b + w + t];
+                v[b + w + t] = v[b + 2 * w - 1 - t];
+                v[b + 2 * w - 1 - t] = x;
+            }
+            for (int t = b + w; t < b + 2 * w; t++)
+                v[t] = _mm_shuffle_epi32(v[t], _MM_SHUFFLE(0, 1, 2, 3));
+            for (int d = w; d >= 1; d /= 2)
+                for (int i = b; i < b + 2 * w; i++)
+                    if (!((i - b) & d)) {
+                        __m128i lo = _mm_min_epi32(v[i], v[i + d]);
+                        v[i + d] = _mm_max_epi32(v[i], v[i + d]);
+                        v[i] = lo;
+                    }
+            for (int i = b; i < b + 2 * w; i++) v[i] = cleanVec4(v[i]);
+        }
+    }
+}
+
+__attribute__((target("sse4.1")))
+static void sortNetSSE4(int arr[], int n) {
+    int buf[SORTNET_MAX];
+    __m128i v[SORTNET_MAX / 4];
+    int nv = 1;
+    while (nv * 4 < n) nv *= 2;
+    for (int i = 0; i < nv * 4; i++) buf[i] = (i < n) ? arr[i] : INT_MAX;
+    for (int i = 0; i < nv; i++)
+        v[i] = sortVec4(_mm_loadu_si128((const __m128i*)(buf + 4 * i)));
+    mergeVecs4(v, nv);
+    for (int i = 0; i < nv; i++) _mm_storeu_si128((__m128i*)(buf + 4 * i), v[i]);
+    memcpy(arr, buf, n * sizeof(int));
+}
+
+static void (*sortNetKernel)(int[], int) = insertionSort;
+static pthread_once_t sortNetOnce = PTHREAD_ONCE_INIT;
+
+static void sortNetInit(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) sortNetKernel = sortNetAVX2;
+    else if (__builtin_cpu_supports("sse4.1")) sortNetKernel = sortNetSSE4;
+}
+
+#ifdef SORT_STATS
+// A bitonic sort of m = 2^k keys has m/2 * k(k+1)/2 comparators; n is padded
+// up to a power-of-two number of vectors of the given lane count.
+static void countSortNet(int n, int lanes) {
+    int m = lanes, k = 0;
+    while (m < n) m *= 2;
+    for (int x = m; x > 1; x >>= 1) k++;
+    sortCmps += (long long)m / 2 * k * (k + 1) / 2;
+    sortSwaps += n;
+}
+#endif
+
+void sortSmall(int arr[], int n) {
+    if (n < 2) return;
+    if (n > SORTNET_MAX) {
+        insertionSort(arr, n);
+        return;
+    }
+    pthread_once(&sortNetOnce, sortNetInit);
+#ifdef SORT_STATS
+    if (sortNetKernel != insertionSort) countSortNet(n, sortNetKernel == sortNetAVX2 ? 8 : 4);
+#endif
+    sortNetKernel(arr, n);
+}
+#else
+void sortSmall(int arr[], int n) {
+    insertionSort(arr, n);
+}
+#endif
+
 // Merge Sort
+// mergeTwo() merges sorted a[0, na) and b[0, nb) into out[], which must not
+// overlap a; it may overlap b only if b is the tail of out, since no write
+// passes the part of b already read. With AVX2 it streams both inputs through registers: the 8
+// kept back and the next 8 from whichever input has the smaller head are
+// merged by a bitonic network (reverse one, min/max, clean both halves),
+// the lower 8 are stored and the upper 8 are kept. Scalar elsewhere.
+static void mergeTwoScalar(const int a[], int na, const int b[], int nb, int out[]) {
+    int i = 0, j = 0, k = 0;
+    while (i < na && j < nb)
+        out[k++] = (a[i] <= b[j]) ? a[i++] : b[j++];
+    while (i < na) out[k++] = a[i++];
+    while (j < nb) out[k++] = b[j++];
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+__attribute__((target("avx2")))
+static inline void mergeVec16(__m256i *lo, __m256i *hi) {
+    __m256i r = _mm256_permutevar8x32_epi32(*hi, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    __m256i mn = _mm256_min_epi32(*lo, r), mx = _mm256_max_epi32(*lo, r);
+    *lo = cleanVec8(mn);
+    *hi = cleanVec8(mx);
+}
+
+__attribute__((target("avx2")))
+static void mergeTwoAVX2(const int a[], int na, const int b[], int nb, int out[]) {
+    if (na < 8 || nb < 8) {
+        mergeTwoScalar(a, na, b, nb, out);
+        return;
+    }
+    __m256i lo = _mm256_loadu_si256((const __m256i*)a);
+    __m256i hi = _mm256_loadu_si256((const __m256i*)b);
+    mergeVec16(&lo, &hi);
+    _mm256_storeu_si256((__m256i*)out, lo);
+    int i = 8, j = 8, k = 8;
+    while (i + 8 <= na && j + 8 <= nb) {
+        int takeA = a[i] <= b[j];
+        lo = _mm256_loadu_si256((const __m256i*)(takeA ? a + i : b + j));
+        i += takeA ? 8 : 0;
+        j += takeA ? 0 : 8;
+        mergeVec16(&lo, &hi);
+        _mm256_storeu_si256((__m256i*)(out + k), lo);
+        k += 8;
+    }
+    // Under 8 left on one side: merge it with the kept 8, then that with
+    // the rest of the other side.
+    int kept[8], small[16];
+    _mm256_storeu_si256((__m256i*)kept, hi);
+    int shortA = na - i < 8;
+    const int *s = shortA ? a + i : b + j, *rest = shortA ? b + j : a + i;
+    int ns = shortA ? na - i : nb - j, nr = shortA ? nb - j : na - i;
+    mergeTwoScalar(kept, 8, s, ns, small);
+    mergeTwoScalar(small, 8 + ns, rest, nr, out + k);
+}
+
+static void (*mergeKernel)(const int[], int, const int[], int, int[]) = mergeTwoScalar;
+static pthread_once_t mergeOnce = PTHREAD_ONCE_INIT;
+
+static void mergeInit(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) mergeKernel = mergeTwoAVX2;
+}
+
+void mergeTwo(const int a[], int na, const int b[], int nb, int out[]) {
+    pthread_once(&mergeOnce, mergeInit);
+    mergeKernel(a, na, b, nb, out);
+}
+#else
+void mergeTwo(const int a[], int na, const int b[], int nb, int out[]) {
+    mergeTwoScalar(a, na, b, nb, out);
+}
+#endif
+
+#ifdef SORT_STATS
+// Comparisons the scalar merge makes: one per output until a side runs out.
+// If a runs out first that is all of a plus the b keys below a's last;
+// otherwise all of b plus the a keys up to b's last. Two binary searches
+// give the exact count, so merge() keeps the SIMD kernel under SORT_STATS.
+static long long mergeCmpCount(const int a[], int na, const int b[], int nb) {
+    if (na == 0 || nb == 0) return 0;
+    int lo = 0, hi;
+    if (a[na - 1] <= b[nb - 1]) {
+        for (hi = nb; lo < hi; ) {
+            int mid = lo + (hi - lo) / 2;
+            if (b[mid] < a[na - 1]) lo = mid + 1;
+            else hi = mid;
+        }
+        return na + lo;
+    }
+    for (hi = na; lo < hi; ) {
+        int mid = lo + (hi - lo) / 2;
+        if (a[mid] <= b[nb - 1]) lo = mid + 1;
+        else hi = mid;
+    }
+    return nb + lo;
+}
+#endif
+
 void merge(int arr[], int l, int m, int r) {
     int n1 = m - l + 1, n2 = r - m;
     int L[n1], R[n2];
     for (int i = 0; i < n1; i++) L[i] = arr[l + i];
     for (int i = 0; i < n2; i++) R[i] = arr[m + 1 + i];
-    
-    int i = 0, j = 0, k = l;
-    while (i < n1 && j < n2)
-        arr[k++] = (L[i] <= R[j]) ? L[i++] : R[j++];
-    while (i < n1) arr[k++] = L[i++];
-    while (j < n2) arr[k++] = R[j++];
+#ifdef SORT_STATS
+    sortCmps += mergeCmpCount(L, n1, R, n2);
+#endif
+    mergeTwo(L, n1, R, n2, arr + l);
+    COUNT_SWAP(n1 + n2);
 }
 
 void mergeSort(int arr[], int l, int r) {
-    if (l < r) {
+    if (r - l < SORTNET_MAX) {
+        sortSmall(arr + l, r - l + 1);
+    } else {
         int m = (l + r) / 2;
         mergeSort(arr, l, m);
         mergeSort(arr, m + 1, r);
@@ -71,20 +361,405 @@ void mergeSort(int arr[], int l, int r) {
     }
 }
 
+// Bottom-up Merge Sort with one n-sized scratch buffer (pass NULL to have it
+// allocated). Passes ping-pong between arr and buf, so nothing is copied back
+// per level; pairs already in order (a[m-1] <= a[m]) are copied, not merged.
+#define MERGE_RUN SORTNET_MAX
+
+void mergeSortBottomUp(int arr[], int n, int buf[]) {
+    if (n < 2) return;
+    int *tmp = buf ? buf : (int*)malloc(n * sizeof(int));
+    if (!tmp) {
+        mergeSort(arr, 0, n - 1);
+        return;
+    }
+    for (int i = 0; i < n; i += MERGE_RUN)
+        sortSmall(arr + i, (n - i < MERGE_RUN) ? n - i : MERGE_RUN);
+
+    int *src = arr, *dst = tmp;
+    for (int w = MERGE_RUN; w < n; w *= 2) {
+        for (int l = 0; l < n; l += 2 * w) {
+            int m = (l + w < n) ? l + w : n;
+            int r = (m + w < n) ? m + w : n;
+            if (m == r || src[m - 1] <= src[m])
+                memcpy(dst + l, src + l, (r - l) * sizeof(int));
+            else
+                mergeTwo(src + l, m - l, src + m, r - m, dst + l);
+        }
+        int *t = src; src = dst; dst = t;
+    }
+    if (src != arr) memcpy(arr, src, n * sizeof(int));
+    if (!buf) free(tmp);
+}
+
+// Tim Sort (adaptive natural merge sort)
+// Takes ascending runs as they are and reverses strictly descending ones,
+// extends short runs to minRun (17..32) with sortSmall(), and merges
+// through a run stack that keeps the Timsort balance invariants. A merge
+// gallops once a whole block of output came from one side, so nearly sorted
+// input costs close to O(n); otherwise it hands the next stretch to
+// mergeTwo(). Input in which every run had to be forced looks random; it
+// skips the run stack and is merged in plain bottom-up passes instead.
+// Stable; needs at most n/2 scratch ints.
+#define TIM_MIN_GALLOP 7
+#define TIM_MAX_RUNS 85
+#define TIM_BULK 1024
+#define TIM_TILE (1 << 15)
+
+typedef struct {
+    int *a, *tmp;
+    int minGallop, runs;
+    int runBase[TIM_MAX_RUNS], runLen[TIM_MAX_RUNS];
+} TimState;
+
+static int timMinRun(int n) {
+    int r = 0;
+    while (n > SORTNET_MAX) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+// Length of the run starting at lo; a strictly descending run is reversed.
+static int timCountRun(int a[], int lo, int hi) {
+    int r = lo + 1;
+    if (r == hi) return 1;
+    if (a[r++] < a[lo]) {
+        while (r < hi && a[r] < a[r - 1]) r++;
+        for (int i = lo, j = r - 1; i < j; i++, j--) {
+            int t = a[i]; a[i] = a[j]; a[j] = t;
+        }
+    } else {
+        while (r < hi && a[r] >= a[r - 1]) r++;
+    }
+    return r - lo;
+}
+
+// Sorts a[lo, hi) given that a[lo, start) is already sorted.
+static void binaryInsertionSort(int a[], int lo, int hi, int start) {
+    for (; start < hi; start++) {
+        int key = a[start], l = lo, r = start;
+        while (l < r) {
+            int m = l + (r - l) / 2;
+            if (key < a[m]) r = m;
+            else l = m + 1;
+        }
+        memmove(a + l + 1, a + l, (start - l) * sizeof(int));
+        a[l] = key;
+    }
+}
+
+// Number of leading a[0, n) that are < key (right == 0) or <= key (right == 1),
+// found by exponential search from the front or the back, then bisection.
+static int gallop(int key, const int a[], int n, int fromEnd, int right) {
+    #define GALLOP_BEFORE(i) (right ? a[i] <= key : a[i] < key)
+    int lo, hi, ofs = 1, last = 0;
+    if (!fromEnd) {
+        if (n == 0 || !GALLOP_BEFORE(0)) return 0;
+        while (ofs < n && GALLOP_BEFORE(ofs)) {
+            last = ofs;
+            ofs = ofs > (n - 1) / 2 ? n : 2 * ofs + 1;  // clamped: doubling could overflow
+        }
+        lo = last + 1;
+        hi = ofs < n ? ofs : n;
+    } else {
+        if (n == 0 || GALLOP_BEFORE(n - 1)) return n;
+        while (ofs < n && !GALLOP_BEFORE(n - 1 - ofs)) {
+            last = ofs;
+            ofs = ofs > (n - 1) / 2 ? n : 2 * ofs + 1;
+        }
+        lo = ofs < n ? n - ofs : 0;
+        hi = n - 1 - last;
+    }
+    while (lo < hi) {
+        int m = lo + (hi - lo) / 2;
+        if (GALLOP_BEFORE(m)) lo = m + 1;
+        else hi = m;
+    }
+    return lo;
+    #undef GALLOP_BEFORE
+}
+
+// Bulk step once a probe block came out mixed: the heads of t[0, nA) and
+// b[0, nB), at most TIM_BULK from each, go through mergeTwo() into out[],
+// cut where the side whose stretch ends lower runs out. b may be the tail
+// of out. Returns how many came from t; *fromB gets the rest.
+static int timBulk(const int t[], int nA, const int b[], int nB, int out[], int *fromB) {
+    int c = nA < TIM_BULK ? nA : TIM_BULK, d = nB < TIM_BULK ? nB : TIM_BULK;
+    if (t[c - 1] <= b[d - 1]) d = gallop(t[c - 1], b, d, 0, 0);
+    else c = gallop(b[d - 1], t, c, 0, 1);
+    mergeTwo(t, c, b, d, out);
+    *fromB = d;
+    return c;
+}
+
+// Merge with the left run in tmp, filling a[] from the front.
+static void timMergeLo(TimState *ts, int base1, int len1, int base2, int len2) {
+    int *a = ts->a, *t = ts->tmp, minGallop = ts->minGallop;
+    memcpy(t, a + base1, len1 * sizeof(int));
+    int i = 0, j = base2, k = base1, endB = base2 + len2;
+    while (i < len1 && j < endB) {
+        // Probe branch-free with a block of minGallop; a block drawn
+        // entirely from one side means the runs are lopsided here, so
+        // gallop, otherwise merge the next stretch in bulk.
+        int block = minGallop, fromB = 0;
+        if (block > len1 - i) block = len1 - i;
+        if (block > endB - j) block = endB - j;
+        for (int c = 0; c < block; c++) {
+            int takeB = a[j] < t[i];
+            a[k++] = takeB ? a[j] : t[i];
+            j += takeB;
+            i += !takeB;
+            fromB += takeB;
+        }
+        if (fromB != 0 && fromB != block) {
+            if (i < len1 && j < endB) {
+                int d, c = timBulk(t + i, len1 - i, a + j, endB - j, a + k, &d);
+                i += c; j += d; k += c + d;
+            }
+            continue;
+        }
+        while (i < len1 && j < endB) {
+            int c = gallop(a[j], t + i, len1 - i, 0, 1);
+            memcpy(a + k, t + i, c * sizeof(int));
+            k += c; i += c;
+            if (i == len1) break;
+            int d = gallop(t[i], a + j, endB - j, 0, 0);
+            memmove(a + k, a + j, d * sizeof(int));
+            k += d; j += d;
+            if (c < TIM_MIN_GALLOP && d < TIM_MIN_GALLOP) {
+                minGallop++;
+                break;
+            }
+            if (minGallop > 1) minGallop--;
+        }
+    }
+    memcpy(a + k, t + i, (len1 - i) * sizeof(int));
+    ts->minGallop = minGallop;
+}
+
+// Merge with the right run in tmp, filling a[] from the back.
+static void timMergeHi(TimState *ts, int base1, int len1, int base2, int len2) {
+    int *a = ts->a, *t = ts->tmp, minGallop = ts->minGallop;
+    memcpy(t, a + base2, len2 * sizeof(int));
+    int i = base1 + len1 - 1, j = len2 - 1, k = base2 + len2 - 1;
+    while (i >= base1 && j >= 0) {
+        int block = minGallop, fromA = 0;
+        if (block > i - base1 + 1) block = i - base1 + 1;
+        if (block > j + 1) block = j + 1;
+        for (int c = 0; c < block; c++) {
+            int takeA = t[j] < a[i];
+            a[k--] = takeA ? a[i] : t[j];
+            i -= takeA;
+            j -= !takeA;
+            fromA += takeA;
+        }
+        if (fromA != 0 && fromA != block) {
+            // Mirror of timBulk(), cut from the top: the left stretch is
+            // slid up against the merged part so that it is the tail of
+            // its output, then merged forward with the right stretch.
+            // Equal ints are indistinguishable, so the swapped order is fine.
+            if (i >= base1 && j >= 0) {
+                int c = i - base1 + 1, d = j + 1;
+                if (c > TIM_BULK) c = TIM_BULK;
+                if (d > TIM_BULK) d = TIM_BULK;
+                const int *l = a + i - c + 1, *r = t + j - d + 1;
+                if (*l <= *r) c -= gallop(*r, l, c, 1, 1);
+                else d -= gallop(*l, r, d, 1, 0);
+                memmove(a + k - c + 1, a + i - c + 1, c * sizeof(int));
+                mergeTwo(t + j - d + 1, d, a + k - c + 1, c, a + k - c - d + 1);
+                i -= c; j -= d; k -= c + d;
+            }
+            continue;
+        }
+        while (i >= base1 && j >= 0) {
+            int nA = i - base1 + 1;
+            int c = nA - gallop(t[j], a + base1, nA, 1, 1);
+            memmove(a + k - c + 1, a + i - c + 1, c * sizeof(int));
+            k -= c; i -= c;
+            if (i < base1) break;
+            int d = j + 1 - gallop(a[i], t, j + 1, 1, 0);
+            memcpy(a + k - d + 1, t + j - d + 1, d * sizeof(int));
+            k -= d; j -= d;
+            if (c < TIM_MIN_GALLOP && d < TIM_MIN_GALLOP) {
+                minGallop++;
+                break;
+            }
+            if (minGallop > 1) minGallop--;
+        }
+    }
+    memcpy(a + base1, t, (j + 1) * sizeof(int));
+    ts->minGallop = minGallop;
+}
+
+// Merges stack runs i and i + 1, trimming the parts already in place first.
+static void timMergeAt(TimState *ts, int i) {
+    int base1 = ts->runBase[i], len1 = ts->runLen[i];
+    int base2 = ts->runBase[i + 1], len2 = ts->runLen[i + 1];
+    ts->runLen[i] = len1 + len2;
+    if (i == ts->runs - 3) {
+        ts->runBase[i + 1] = ts->runBase[i + 2];
+        ts->runLen[i + 1] = ts->runLen[i + 2];
+    }
+    ts->runs--;
+
+    int k = gallop(ts->a[base2], ts->a + base1, len1, 0, 1);
+    base1 += k;
+    len1 -= k;
+    if (len1 == 0) return;
+    len2 = gallop(ts->a[base1 + len1 - 1], ts->a + base2, len2, 1, 0);
+    if (len2 == 0) return;
+    if (len1 <= len2) timMergeLo(ts, base1, len1, base2, len2);
+    else timMergeHi(ts, base1, len1, base2, len2);
+}
+
+static void timMergeCollapse(TimState *ts) {
+    int *len = ts->runLen;
+    while (ts->runs > 1) {
+        int n = ts->runs - 2;
+        if ((n > 0 && len[n - 1] <= len[n] + len[n + 1]) ||
+            (n > 1 && len[n - 2] <= len[n - 1] + len[n])) {
+            if (len[n - 1] < len[n + 1]) n--;
+        } else if (len[n] > len[n + 1]) {
+            break;
+        }
+        timMergeAt(ts, n);
+    }
+}
+
+static void timPushRun(TimState *ts, int base, int len) {
+    ts->runBase[ts->runs] = base;
+    ts->runLen[ts->runs++] = len;
+    timMergeCollapse(ts);
+}
+
+// Merges the sorted width-blocks of a[0, n) pairwise, doubling width each
+// pass. The shorter side of a pair goes to tmp and the merge lands in place;
+// when that is the right side, the left one is slid up to the end of the
+// pair first (equal ints are indistinguishable, so the order is fine).
+static void timMergePasses(int a[], int n, int tmp[], int width) {
+    for (; width < n; width = width > n / 2 ? n : 2 * width) {
+        for (int l = 0; l < n - width; l += 2 * width) {
+            int m = l + width, r = (n - m > width) ? m + width : n;
+            int len1 = m - l, len2 = r - m;
+            if (a[m - 1] <= a[m]) continue;
+            if (len1 <= len2) {
+                memcpy(tmp, a + l, len1 * sizeof(int));
+                mergeTwo(tmp, len1, a + m, len2, a + l);
+            } else {
+                memcpy(tmp, a + m, len2 * sizeof(int));
+                memmove(a + l + len2, a + l, len1 * sizeof(int));
+                mergeTwo(tmp, len2, a + l + len2, len1, a + l);
+            }
+        }
+    }
+}
+
+void timSort(int arr[], int n) {
+    if (n < 2) return;
+    if (n < 64) {
+        binaryInsertionSort(arr, 0, n, timCountRun(arr, 0, n));
+        return;
+    }
+    TimState ts = {arr, (int*)malloc((n / 2 + 1) * sizeof(int)), TIM_MIN_GALLOP, 0, {0}, {0}};
+    if (!ts.tmp) {
+        mergeSort(arr, 0, n - 1);
+        return;
+    }
+    // Forced blocks are only counted until the first natural run turns up;
+    // then the ones seen so far go onto the stack, minRun ints each.
+    int minRun = timMinRun(n), forced = 0, natural = 0;
+    for (int lo = 0; lo < n; ) {
+        int run = timCountRun(arr, lo, n);
+        if (run < minRun) {
+            // Equal ints are indistinguishable, so the network keeps it stable.
+            int force = (n - lo < minRun) ? n - lo : minRun;
+            sortSmall(arr + lo, force);
+            run = force;
+        } else if (!natural) {
+            natural = 1;
+            for (int b = 0; b < forced; b += minRun) timPushRun(&ts, b, minRun);
+        }
+        if (natural) timPushRun(&ts, lo, run);
+        else forced += run;
+        lo += run;
+    }
+    if (!natural) {
+        // Cache-sized tiles first, so the early passes stay in L2.
+        int tile = minRun;
+        while (tile <= TIM_TILE / 2 && tile < n) tile *= 2;
+        for (int lo = 0; lo < n; lo += tile)
+            timMergePasses(arr + lo, (n - lo < tile) ? n - lo : tile, ts.tmp, minRun);
+        timMergePasses(arr, n, ts.tmp, tile);
+        free(ts.tmp);
+        return;
+    }
+    while (ts.runs > 1) {
+        int i = ts.runs - 2;
+        if (i > 0 && ts.runLen[i - 1] < ts.runLen[i + 1]) i--;
+        timMergeAt(&ts, i);
+    }
+    free(ts.tmp);
+}
+
 // Quick Sort
+// Block partition (BlockQuicksort): offsets of misplaced elements on each
+// side are collected into small buffers without branching, then swapped in
+// bulk. The leftover middle (under two blocks) gets the plain Lomuto scan.
+// Pivot is arr[h]; returns its final index with < p on the left, >= p right.
+#define PART_BLOCK 128
+
 int partition(int arr[], int l, int h) {
-    int p = arr[h], i = l - 1;
-    for (int j = l; j < h; j++)
-        if (arr[j] < p) {
+    int p = arr[h];
+    int *first = arr + l, *last = arr + h - 1;
+    unsigned char offL[PART_BLOCK], offR[PART_BLOCK];
+    int startL = 0, numL = 0, startR = 0, numR = 0;
+
+    while (last - first + 1 >= 2 * PART_BLOCK) {
+        if (numL == 0) {
+            startL = 0;
+            for (int i = 0; i < PART_BLOCK; i++) {
+                offL[numL] = i;
+                numL += COUNT_CMP(first[i] >= p);
+            }
+        }
+        if (numR == 0) {
+            startR = 0;
+            for (int i = 0; i < PART_BLOCK; i++) {
+                offR[numR] = i;
+                numR += COUNT_CMP(*(last - i) < p);
+            }
+        }
+        int num = numL < numR ? numL : numR;
+        COUNT_SWAP(num);
+        for (int k = 0; k < num; k++) {
+            int *a = first + offL[startL + k], *b = last - offR[startR + k];
+            int t = *a; *a = *b; *b = t;
+        }
+        numL -= num; numR -= num;
+        startL += num; startR += num;
+        if (numL == 0) first += PART_BLOCK;
+        if (numR == 0) last -= PART_BLOCK;
+    }
+
+    // A half-swapped block never moved its bound, so [first, last] covers it.
+    int *i = first - 1;
+    for (int *j = first; j <= last; j++)
+        if (COUNT_CMP(*j < p)) {
+            COUNT_SWAP(1);
             i++;
-            int t = arr[i]; arr[i] = arr[j]; arr[j] = t;
+            int t = *i; *i = *j; *j = t;
         }
-    int t = arr[i + 1]; arr[i + 1] = arr[h]; arr[h] = t;
-    return i + 1;
+    COUNT_SWAP(1);
+    int t = i[1]; i[1] = arr[h]; arr[h] = t;
+    return (int)(i + 1 - arr);
 }
 
 void quickSort(int arr[], int l, int h) {
-    if (l < h) {
+    if (h - l < SORTNET_MAX) {
+        sortSmall(arr + l, h - l + 1);
+    } else {
         int p = partition(arr, l, h);
         quickSort(arr, l, p - 1);
         quickSort(arr, p + 1, h);
@@ -92,22 +767,1123 @@ void quickSort(int arr[], int l, int h) {
 }
 
 // Heap Sort
+// 4-ary max-heap: the children of i are 4i+1..4i+4, side by side, so a level
+// touches one cache line instead of two and the tree is half as deep.
+// Sifting is Floyd's bottom-up variant: the hole walks down to a leaf along
+// the larger child without comparing against the key, then the key climbs
+// back up, which is short since it usually belongs near the bottom.
+// Grandchildren are prefetched one level ahead. Iterative, O(1) space.
+#define HEAP_D 4
+
+static int heapMaxChild(const int arr[], int n, int c) {
+    if (c + HEAP_D <= n) {
+        int a = c + COUNT_CMP(arr[c + 1] > arr[c]);
+        int b = c + 2 + COUNT_CMP(arr[c + 3] > arr[c + 2]);
+        int ka = arr[a], kb = arr[b];
+        return COUNT_CMP(kb > ka) ? b : a;
+    }
+    int m = c;
+    for (int k = c + 1; k < n; k++)
+        if (COUNT_CMP(arr[k] > arr[m])) m = k;
+    return m;
+}
+
+// Fills the hole at i with key x, keeping the subtree under i a heap.
+static void heapSiftHole(int arr[], int n, int i, int x) {
+    int hole = i, c;
+    while ((c = HEAP_D * hole + 1) < n) {
+        if (HEAP_D * c + 1 < n) __builtin_prefetch(arr + HEAP_D * c + 1);
+        int m = heapMaxChild(arr, n, c);
+        arr[hole] = arr[m];
+        hole = m;
+        COUNT_SWAP(1);
+    }
+    while (hole > i) {
+        int p = (hole - 1) / HEAP_D;
+        if (COUNT_CMP(arr[p] >= x)) break;
+        arr[hole] = arr[p];
+        hole = p;
+        COUNT_SWAP(1);
+    }
+    arr[hole] = x;
+}
+
 void heapify(int arr[], int n, int i) {
-    int l = 2 * i + 1, r = 2 * i + 2, max = i;
-    if (l < n && arr[l] > arr[max]) max = l;
-    if (r < n && arr[r] > arr[max]) max = r;
-    if (max != i) {
-        int t = arr[i]; arr[i] = arr[max]; arr[max] = t;
-        heapify(arr, n, max);
-    }
+    heapSiftHole(arr, n, i, arr[i]);
 }
 
 void heapSort(int arr[], int n) {
-    for (int i = n/2 - 1; i >= 0; i--) heapify(arr, n, i);
+    for (int i = (n - 2) / HEAP_D; n > 1 && i >= 0; i--) heapify(arr, n, i);
     while (--n > 0) {
-        int t = arr[0]; arr[0] = arr[n]; arr[n] = t;
-        heapify(arr, n, 0);
+        // The last leaf is taken out, the max goes into its slot, and the
+        // leaf refills the hole left at the root.
+        int x = arr[n];
+        arr[n] = arr[0];
+        COUNT_SWAP(1);
+        heapSiftHole(arr, n, 0, x);
+    }
+}
+
+// Intro Sort
+// Median-of-three (ninther on large ranges) quicksort over partition(),
+// sortSmall() below the cutoff, heapSort once the depth budget runs out,
+// and the three-way loop below once a range looks duplicate-heavy.
+// Recurses into the smaller side only, so the stack stays O(log n).
+#define INTRO_CUTOFF SORTNET_MAX
+
+int medianOf3(int arr[], int a, int b, int c) {
+    if (COUNT_CMP(arr[a] < arr[b]))
+        return COUNT_CMP(arr[b] < arr[c]) ? b : (COUNT_CMP(arr[a] < arr[c]) ? c : a);
+    return COUNT_CMP(arr[a] < arr[c]) ? a : (COUNT_CMP(arr[b] < arr[c]) ? c : b);
+}
+
+int choosePivot(int arr[], int l, int h) {
+    int m = l + (h - l) / 2;
+    if (h - l < 128) return medianOf3(arr, l, m, h);
+    int s = (h - l) / 8;
+    return medianOf3(arr, medianOf3(arr, l, l + s, l + 2 * s),
+                          medianOf3(arr, m - s, m, m + s),
+                          medianOf3(arr, h - 2 * s, h - s, h));
+}
+
+// Three-Way Quick Sort
+// Dijkstra's Dutch national flag partition: one pass leaves arr[l, *lt) < p,
+// arr[*lt, *gt] == p and arr(*gt, h] > p for p = arr[h], and keys equal to
+// the pivot are never touched again. With u distinct keys the recursion is
+// about log u deep, so low-cardinality input sorts in close to linear time.
+void partition3(int arr[], int l, int h, int *lt, int *gt) {
+    int p = arr[h], a = l, i = l, b = h, t;
+    while (i <= b) {
+        if (COUNT_CMP(arr[i] < p)) {
+            COUNT_SWAP(1);
+            t = arr[a]; arr[a++] = arr[i]; arr[i++] = t;
+        } else if (COUNT_CMP(arr[i] > p)) {
+            COUNT_SWAP(1);
+            t = arr[b]; arr[b--] = arr[i]; arr[i] = t;
+        } else {
+            i++;
+        }
+    }
+    *lt = a;
+    *gt = b;
+}
+
+static int introDepth(int n) {
+    int depth = 0;
+    for (; n > 1; n >>= 1) depth += 2;
+    return depth;
+}
+
+static void quickSort3WayLoop(int arr[], int l, int h, int depth) {
+    while (h - l + 1 > INTRO_CUTOFF) {
+        if (depth-- == 0) {
+            heapSort(arr + l, h - l + 1);
+            return;
+        }
+        int m = choosePivot(arr, l, h), lt, gt;
+        int t = arr[m]; arr[m] = arr[h]; arr[h] = t;
+        partition3(arr, l, h, &lt, &gt);
+        if (lt - l < h - gt) {
+            quickSort3WayLoop(arr, l, lt - 1, depth);
+            l = gt + 1;
+        } else {
+            quickSort3WayLoop(arr, gt + 1, h, depth);
+            h = lt - 1;
+        }
     }
+    if (l < h) sortSmall(arr + l, h - l + 1);
+}
+
+void quickSort3Way(int arr[], int l, int h) {
+    quickSort3WayLoop(arr, l, h, introDepth(h - l + 1));
+}
+
+// Duplicate detector: sorts a strided sample of DUP_SAMPLE keys (h - l + 1
+// must be at least that) and counts equal neighbours. Distinct keys almost
+// never collide in a sample this small, so a handful of equal pairs means
+// few distinct values.
+#define DUP_SAMPLE SORTNET_MAX
+#define DUP_CHECK_MIN 1024
+
+int sampleDuplicates(const int arr[], int l, int h) {
+    int s[DUP_SAMPLE], step = (h - l + 1) / DUP_SAMPLE, eq = 0;
+    for (int i = 0; i < DUP_SAMPLE; i++) s[i] = arr[l + i * step];
+    sortSmall(s, DUP_SAMPLE);
+    for (int i = 1; i < DUP_SAMPLE; i++) eq += COUNT_CMP(s[i] == s[i - 1]);
+    return eq;
+}
+
+int manyDuplicates(const int arr[], int l, int h) {
+    return sampleDuplicates(arr, l, h) >= DUP_SAMPLE / 8;
+}
+
+void introSortLoop(int arr[], int l, int h, int depth) {
+    while (h - l + 1 > INTRO_CUTOFF) {
+        if (depth-- == 0) {
+            heapSort(arr + l, h - l + 1);
+            return;
+        }
+        // Ranges heavy in one key switch to three-way partitioning for good.
+        if (h - l + 1 >= DUP_CHECK_MIN && manyDuplicates(arr, l, h)) {
+            quickSort3WayLoop(arr, l, h, depth);
+            return;
+        }
+        int m = choosePivot(arr, l, h);
+        int t = arr[m]; arr[m] = arr[h]; arr[h] = t;
+        int p = partition(arr, l, h);
+        if (p - l < h - p) {
+            introSortLoop(arr, l, p - 1, depth);
+            l = p + 1;
+        } else {
+            introSortLoop(arr, p + 1, h, depth);
+            h = p - 1;
+        }
+    }
+    if (l < h) sortSmall(arr + l, h - l + 1);
+}
+
+void introSort(int arr[], int l, int h) {
+    introSortLoop(arr, l, h, introDepth(h - l + 1));
+}
+
+// Selection
+// introSelect() leaves the k-th smallest of arr[l..h] at arr[k], with
+// nothing larger before it and nothing smaller after. It is quickselect
+// over choosePivot() and partition() with the same depth budget as
+// introSort; once that runs out it switches to median-of-medians pivots,
+// which are linear in the worst case. Expected time is O(n) either way.
+static void selectLoop(int arr[], int l, int h, int k, int depth);
+
+// Median of the group-of-5 medians, which are gathered at arr[l..].
+static int medianOfMedians(int arr[], int l, int h) {
+    int m = l;
+    for (int i = l; i + 4 <= h; i += 5) {
+        insertionSort(arr + i, 5);
+        int t = arr[m]; arr[m] = arr[i + 2]; arr[i + 2] = t;
+        m++;
+    }
+    int mid = l + (m - 1 - l) / 2;
+    selectLoop(arr, l, m - 1, mid, 0);
+    return mid;
+}
+
+static void selectLoop(int arr[], int l, int h, int k, int depth) {
+    while (h - l + 1 > INTRO_CUTOFF) {
+        int m;
+        if (depth > 0) {
+            depth--;
+            m = choosePivot(arr, l, h);
+        } else {
+            m = medianOfMedians(arr, l, h);
+        }
+        int t = arr[m]; arr[m] = arr[h]; arr[h] = t;
+        int p = partition(arr, l, h);
+        if (k < p) {
+            h = p - 1;
+        } else if (k == p) {
+            return;
+        } else if (depth > 0) {
+            l = p + 1;
+        } else {
+            // Keys equal to the pivot all land right of p; pull them next
+            // to it so a run of duplicates cannot stall the fallback.
+            int e = p;
+            for (int i = p + 1; i <= h; i++)
+                if (arr[i] == arr[p]) {
+                    t = arr[++e]; arr[e] = arr[i]; arr[i] = t;
+                }
+            if (k <= e) return;
+            l = e + 1;
+        }
+    }
+    if (l < h) sortSmall(arr + l, h - l + 1);
+}
+
+void introSelect(int arr[], int l, int h, int k) {
+    if (k < l || k > h) return;
+    selectLoop(arr, l, h, k, introDepth(h - l + 1));
+}
+
+// Floyd-Rivest: selects k from a sample of about n^(2/3) first, so the
+// pivot handed to partition() lands within a few sqrt(sample) ranks of k
+// and one pass usually cuts the range to a small window around it. A pass
+// that keeps over 3/4 of the range (runs of duplicates) hands the rest to
+// the median-of-medians loop.
+#define FR_SAMPLE_MIN 600
+
+static int isqrt(long long x) {
+    long long r = 0;
+    for (long long b = 1LL << 62; b; b >>= 2)
+        if (x >= r + b) {
+            x -= r + b;
+            r = (r >> 1) + b;
+        } else {
+            r >>= 1;
+        }
+    return (int)r;
+}
+
+void floydRivestSelect(int arr[], int l, int h, int k) {
+    if (k < l || k > h) return;
+    while (h - l + 1 > INTRO_CUTOFF) {
+        int before = h - l + 1;
+        if (h - l > FR_SAMPLE_MIN) {
+            // Sample size s ~ n^(2/3) / 2, skewed by ~sqrt(s) away from the middle.
+            long long n = h - l + 1, i = k - l + 1;
+            int lg = 31 - __builtin_clz((unsigned)n);
+            long long s = (1LL << (2 * lg / 3)) / 2;
+            long long sd = isqrt(lg * s * (n - s) / n) / 2;
+            if (2 * i < n) sd = -sd;
+            long long nl = k - i * s / n + sd, nh = k + (n - i) * s / n + sd;
+            floydRivestSelect(arr, nl > l ? (int)nl : l, nh < h ? (int)nh : h, k);
+        }
+        int t = arr[k]; arr[k] = arr[h]; arr[h] = t;
+        int p = partition(arr, l, h);
+        if (k < p) h = p - 1;
+        else if (k > p) l = p + 1;
+        else return;
+        if (4 * (h - l + 1) > 3 * before) {
+            selectLoop(arr, l, h, k, 0);
+            return;
+        }
+    }
+    if (l < h) sortSmall(arr + l, h - l + 1);
+}
+
+// std::nth_element for arr[0, n): Floyd-Rivest on large inputs, introSelect
+// below FR_CUTOFF where the sampling does not pay for itself.
+#define FR_CUTOFF (1 << 20)
+
+void nthElement(int arr[], int n, int k) {
+    if (n >= FR_CUTOFF) floydRivestSelect(arr, 0, n - 1, k);
+    else introSelect(arr, 0, n - 1, k);
+}
+
+// Leaves the k smallest of arr[0, n) sorted in arr[0, k); the rest is in
+// no particular order. O(n + k log k).
+void partialSort(int arr[], int n, int k) {
+    if (k <= 0) return;
+    if (k >= n) {
+        introSort(arr, 0, n - 1);
+        return;
+    }
+    nthElement(arr, n, k - 1);
+    introSort(arr, 0, k - 2);
+}
+
+// Streaming Top-K
+// Keeps the k largest values seen across any number of topKAdd() chunks in
+// 2k ints. Values not above the current k-th largest are rejected with one
+// compare; accepted ones are appended, and a full buffer is cut back to k
+// with nthElement(), so each value costs O(1) amortized.
+typedef struct {
+    int *buf;
+    int k, size;
+    int full;       // set once k values are held; threshold is then valid
+    int threshold;  // k-th largest kept so far
+} TopK;
+
+TopK* createTopK(int k) {
+    if (k < 1) return NULL;
+    TopK *t = (TopK*)malloc(sizeof(TopK));
+    if (!t) return NULL;
+    t->buf = (int*)malloc(2 * (size_t)k * sizeof(int));
+    if (!t->buf) {
+        free(t);
+        return NULL;
+    }
+    t->k = k;
+    t->size = t->full = 0;
+    t->threshold = INT_MIN;
+    return t;
+}
+
+// Moves the k largest buffered values to buf[0, k).
+static void topKCompact(TopK *t) {
+    int drop = t->size - t->k;
+    nthElement(t->buf, t->size, drop);
+    memmove(t->buf, t->buf + drop, t->k * sizeof(int));
+    t->size = t->k;
+    t->threshold = t->buf[0];
+    t->full = 1;
+}
+
+void topKAdd(TopK *t, const int arr[], int n) {
+    for (int i = 0; i < n; i++) {
+        if (t->full && arr[i] <= t->threshold) continue;
+        t->buf[t->size++] = arr[i];
+        if (t->size == 2 * t->k) topKCompact(t);
+    }
+}
+
+// Writes the values kept so far to out[] in descending order; returns how
+// many (k, or fewer if fewer were added).
+int topKSorted(TopK *t, int out[]) {
+    if (t->size > t->k) topKCompact(t);
+    introSort(t->buf, 0, t->size - 1);
+    for (int i = 0; i < t->size; i++) out[i] = t->buf[t->size - 1 - i];
+    return t->size;
+}
+
+void freeTopK(TopK *t) {
+    if (!t) return;
+    free(t->buf);
+    free(t);
+}
+
+// Counting Sort
+// O(n + range) for keys known to lie in [min, max]. Falls back to
+// introSort when the count table cannot be allocated.
+void countingSort(int arr[], int n, int min, int max) {
+    if (n < 2 || max < min) return;
+    size_t range = (size_t)((long long)max - min + 1);
+    unsigned *cnt = (unsigned*)calloc(range, sizeof(unsigned));
+    if (!cnt) {
+        introSort(arr, 0, n - 1);
+        return;
+    }
+    for (int i = 0; i < n; i++) cnt[(unsigned)arr[i] - (unsigned)min]++;
+    int k = 0;
+    for (size_t v = 0; v < range; v++)
+        for (unsigned c = cnt[v]; c; c--) arr[k++] = (int)(min + (long long)v);
+    free(cnt);
+}
+
+// Radix Sort (LSD, 11-bit digits, 3 passes)
+// Keys are flipped on the sign bit so negatives sort first. All three
+// histograms come from one read, passes whose digit is the same for every
+// element are skipped, and one scratch buffer is reused across passes.
+#define RADIX_BITS 11
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_MASK (RADIX_BUCKETS - 1)
+#define RADIX_PASSES 3
+#define RADIX_SIGN 0x80000000u
+
+static inline unsigned radixDigit(unsigned x, int pass) {
+    return ((x ^ RADIX_SIGN) >> (pass * RADIX_BITS)) & RADIX_MASK;
+}
+
+void radixSort(int arr[], int n) {
+    if (n < 2) return;
+    unsigned *src = (unsigned*)arr, *dst = (unsigned*)malloc(n * sizeof(unsigned));
+    if (!dst) {
+        introSort(arr, 0, n - 1);
+        return;
+    }
+    unsigned cnt[RADIX_PASSES][RADIX_BUCKETS] = {{0}};
+    for (int i = 0; i < n; i++)
+        for (int p = 0; p < RADIX_PASSES; p++)
+            cnt[p][radixDigit(src[i], p)]++;
+
+    unsigned *buf = dst;
+    for (int p = 0; p < RADIX_PASSES; p++) {
+        if (cnt[p][radixDigit(src[0], p)] == (unsigned)n) continue;
+        unsigned sum = 0;
+        for (int d = 0; d < RADIX_BUCKETS; d++) {
+            unsigned c = cnt[p][d];
+            cnt[p][d] = sum;
+            sum += c;
+        }
+        for (int i = 0; i < n; i++)
+            dst[cnt[p][radixDigit(src[i], p)]++] = src[i];
+        unsigned *t = src; src = dst; dst = t;
+    }
+    if (src != (unsigned*)arr) memcpy(arr, src, n * sizeof(int));
+    free(buf);
+}
+
+// Multi-threaded Radix Sort
+// Each thread owns a contiguous chunk: it builds that chunk's histograms,
+// then scatters it to offsets derived from every thread's counts (thread
+// order inside each bucket keeps the sort stable). Threads meet on a barrier
+// between phases.
+//
+// Workers wait at a start gate until the caller has started every thread it
+// could; the team size and barrier are fixed from that count, so a failed
+// pthread_create shrinks the team instead of leaving the barrier one short.
+typedef struct {
+    pthread_mutex_t mu;
+    pthread_cond_t cv;
+    int open;
+} StartGate;
+
+#define START_GATE_INIT {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0}
+
+static void gatePass(StartGate *g) {
+    pthread_mutex_lock(&g->mu);
+    while (!g->open) pthread_cond_wait(&g->cv, &g->mu);
+    pthread_mutex_unlock(&g->mu);
+}
+
+static void gateOpen(StartGate *g) {
+    pthread_mutex_lock(&g->mu);
+    g->open = 1;
+    pthread_cond_broadcast(&g->cv);
+    pthread_mutex_unlock(&g->mu);
+}
+
+// Starts fn on args[1..threads) (elements of size bytes; size 0 hands every
+// thread args itself) until one fails; returns the team size, counting the
+// caller as thread 0.
+static int startTeam(pthread_t tid[], int threads, void *(*fn)(void*), void *args, size_t size) {
+    int t = 1;
+    while (t < threads && pthread_create(&tid[t], NULL, fn, (char*)args + t * size) == 0) t++;
+    return t;
+}
+
+typedef struct {
+    unsigned *a, *b;
+    int n, threads;
+    unsigned (*cnt)[RADIX_PASSES][RADIX_BUCKETS];  // per thread
+    int skip[RADIX_PASSES];
+    pthread_barrier_t barrier;
+    StartGate gate;
+} RadixShared;
+
+typedef struct {
+    RadixShared *sh;
+    int id;
+} RadixWorker;
+
+static void* radixWorker(void *arg) {
+    RadixWorker *w = (RadixWorker*)arg;
+    RadixShared *sh = w->sh;
+    gatePass(&sh->gate);
+    int t = w->id, T = sh->threads;
+    long lo = (long)sh->n * t / T, hi = (long)sh->n * (t + 1) / T;
+    unsigned (*cnt)[RADIX_BUCKETS] = sh->cnt[t];
+    unsigned *src = sh->a, *dst = sh->b;
+
+    for (long i = lo; i < hi; i++)
+        for (int p = 0; p < RADIX_PASSES; p++)
+            cnt[p][radixDigit(src[i], p)]++;
+    pthread_barrier_wait(&sh->barrier);
+
+    if (t == 0) {
+        for (int p = 0; p < RADIX_PASSES; p++) {
+            unsigned d0 = radixDigit(src[0], p), total = 0;
+            for (int u = 0; u < T; u++) total += sh->cnt[u][p][d0];
+            sh->skip[p] = (total == (unsigned)sh->n);
+        }
+    }
+    pthread_barrier_wait(&sh->barrier);
+
+    int fresh = 1;  // chunk histograms still describe the data in src
+    for (int p = 0; p < RADIX_PASSES; p++) {
+        if (sh->skip[p]) continue;
+        if (!fresh) {
+            memset(cnt[p], 0, sizeof(cnt[p]));
+            for (long i = lo; i < hi; i++) cnt[p][radixDigit(src[i], p)]++;
+            pthread_barrier_wait(&sh->barrier);
+        }
+        unsigned off[RADIX_BUCKETS], sum = 0;
+        for (int d = 0; d < RADIX_BUCKETS; d++) {
+            for (int u = 0; u < T; u++) {
+                if (u == t) off[d] = sum;
+                sum += sh->cnt[u][p][d];
+            }
+        }
+        for (long i = lo; i < hi; i++)
+            dst[off[radixDigit(src[i], p)]++] = src[i];
+        pthread_barrier_wait(&sh->barrier);
+        unsigned *tmp = src; src = dst; dst = tmp;
+        fresh = 0;
+    }
+    if (src != sh->a) memcpy(sh->a + lo, src + lo, (hi - lo) * sizeof(unsigned));
+    return NULL;
+}
+
+void radixSortMT(int arr[], int n, int threads) {
+    if (threads <= 1 || n < (1 << 16)) {
+        radixSort(arr, n);
+        return;
+    }
+    RadixShared sh = {.gate = START_GATE_INIT};
+    sh.a = (unsigned*)arr;
+    sh.b = (unsigned*)malloc(n * sizeof(unsigned));
+    sh.n = n;
+    sh.cnt = calloc(threads, sizeof(*sh.cnt));
+    pthread_t *tid = (pthread_t*)malloc(threads * sizeof(pthread_t));
+    RadixWorker *w = (RadixWorker*)malloc(threads * sizeof(RadixWorker));
+    if (!sh.b || !sh.cnt || !tid || !w) {
+        free(sh.b); free(sh.cnt); free(tid); free(w);
+        radixSort(arr, n);
+        return;
+    }
+    for (int t = 0; t < threads; t++) w[t] = (RadixWorker){&sh, t};
+    sh.threads = startTeam(tid, threads, radixWorker, w, sizeof(RadixWorker));
+    pthread_barrier_init(&sh.barrier, NULL, sh.threads);
+    gateOpen(&sh.gate);
+    radixWorker(&w[0]);
+    for (int t = 1; t < sh.threads; t++) pthread_join(tid[t], NULL);
+    pthread_barrier_destroy(&sh.barrier);
+    free(sh.b); free(sh.cnt); free(tid); free(w);
+}
+
+// Thread Pool
+// Fixed pthread workers over one FIFO task queue. Every task belongs to a
+// TaskGroup, and poolWait() runs queued tasks on the calling thread until its
+// group drains, so nested fork-join never deadlocks on busy workers.
+typedef struct TaskGroup {
+    int pending;
+} TaskGroup;
+
+typedef struct Task {
+    void (*fn)(void*);
+    void *arg;
+    TaskGroup *group;
+    struct Task *next;
+} Task;
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    Task *head, *tail;
+    int stop, threads;
+    pthread_t *tid;
+} ThreadPool;
+
+// Runs one queued task with pool->lock held on entry and exit.
+static void poolRunOne(ThreadPool *pool) {
+    Task *task = pool->head;
+    pool->head = task->next;
+    if (!pool->head) pool->tail = NULL;
+    pthread_mutex_unlock(&pool->lock);
+    task->fn(task->arg);
+    pthread_mutex_lock(&pool->lock);
+    if (--task->group->pending == 0) pthread_cond_broadcast(&pool->cond);
+    free(task);
+}
+
+static void* poolWorker(void *arg) {
+    ThreadPool *pool = (ThreadPool*)arg;
+    pthread_mutex_lock(&pool->lock);
+    while (!pool->stop) {
+        if (pool->head) poolRunOne(pool);
+        else pthread_cond_wait(&pool->cond, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+// threads counts the caller, which works inside poolWait(). If a worker
+// fails to start, the pool keeps the ones that did; with none, every task
+// runs inline in poolSubmit().
+ThreadPool* createThreadPool(int threads) {
+    ThreadPool *pool = (ThreadPool*)calloc(1, sizeof(ThreadPool));
+    if (!pool) return NULL;
+    pool->threads = threads < 1 ? 1 : threads;
+    pool->tid = (pthread_t*)malloc(pool->threads * sizeof(pthread_t));
+    if (!pool->tid) {
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->cond, NULL);
+    pool->threads = startTeam(pool->tid, pool->threads, poolWorker, pool, 0);
+    return pool;
+}
+
+void poolSubmit(ThreadPool *pool, TaskGroup *group, void (*fn)(void*), void *arg) {
+    Task *task = pool->threads > 1 ? (Task*)malloc(sizeof(Task)) : NULL;
+    if (!task) {
+        fn(arg);
+        return;
+    }
+    *task = (Task){fn, arg, group, NULL};
+    pthread_mutex_lock(&pool->lock);
+    group->pending++;
+    if (pool->tail) pool->tail->next = task;
+    else pool->head = task;
+    pool->tail = task;
+    pthread_cond_signal(&pool->cond);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void poolWait(ThreadPool *pool, TaskGroup *group) {
+    pthread_mutex_lock(&pool->lock);
+    while (group->pending > 0) {
+        if (pool->head) poolRunOne(pool);
+        else pthread_cond_wait(&pool->cond, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void freeThreadPool(ThreadPool *pool) {
+    if (!pool) return;
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->cond);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 1; i < pool->threads; i++) pthread_join(pool->tid[i], NULL);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->cond);
+    free(pool->tid);
+    free(pool);
+}
+
+// Parallel Merge Sort / Quick Sort
+// Ranges above PAR_CUTOFF fork one half onto the pool; smaller ranges use the
+// serial kernels. Both produce exactly the serial result.
+#define PAR_CUTOFF (1 << 16)
+
+// Number of elements of a[] among the first k outputs of a stable merge.
+static int coRank(int k, const int a[], int na, const int b[], int nb) {
+    int lo = k > nb ? k - nb : 0, hi = k < na ? k : na;
+    while (lo < hi) {
+        int i = lo + (hi - lo) / 2;
+        if (a[i] <= b[k - i - 1]) lo = i + 1;
+        else hi = i;
+    }
+    return lo;
+}
+
+typedef struct {
+    const int *a, *b;
+    int na, nb, k0, k1;
+    int *out;
+} PMergeChunk;
+
+static void mergeChunkTask(void *p) {
+    PMergeChunk *c = (PMergeChunk*)p;
+    int i0 = coRank(c->k0, c->a, c->na, c->b, c->nb);
+    int i1 = coRank(c->k1, c->a, c->na, c->b, c->nb);
+    int j0 = c->k0 - i0, j1 = c->k1 - i1;
+    mergeTwo(c->a + i0, i1 - i0, c->b + j0, j1 - j0, c->out + c->k0);
+}
+
+// Splits the output into equal slices and merges each one independently.
+void parallelMerge(ThreadPool *pool, const int a[], int na, const int b[], int nb, int out[]) {
+    int n = na + nb, chunks = n / PAR_CUTOFF;
+    if (chunks > 4 * pool->threads) chunks = 4 * pool->threads;
+    if (chunks <= 1) {
+        mergeTwo(a, na, b, nb, out);
+        return;
+    }
+    PMergeChunk *c = (PMergeChunk*)malloc(chunks * sizeof(PMergeChunk));
+    if (!c) {
+        mergeTwo(a, na, b, nb, out);
+        return;
+    }
+    TaskGroup g = {0};
+    for (int t = 0; t < chunks; t++) {
+        c[t] = (PMergeChunk){a, b, na, nb, (int)((long)n * t / chunks),
+                             (int)((long)n * (t + 1) / chunks), out};
+        if (t < chunks - 1) poolSubmit(pool, &g, mergeChunkTask, &c[t]);
+    }
+    mergeChunkTask(&c[chunks - 1]);
+    poolWait(pool, &g);
+    free(c);
+}
+
+typedef struct {
+    ThreadPool *pool;
+    int *a, *tmp;
+    int l, r, toTmp;
+} PMergeSortArgs;
+
+// Sorts [l, r), leaving the result in tmp if toTmp, else in a.
+static void pmsort(ThreadPool *pool, int *a, int *tmp, int l, int r, int toTmp);
+
+static void pmsortTask(void *p) {
+    PMergeSortArgs *s = (PMergeSortArgs*)p;
+    pmsort(s->pool, s->a, s->tmp, s->l, s->r, s->toTmp);
+}
+
+static void pmsort(ThreadPool *pool, int *a, int *tmp, int l, int r, int toTmp) {
+    if (r - l <= PAR_CUTOFF) {
+        mergeSortBottomUp(a + l, r - l, tmp + l);
+        if (toTmp) memcpy(tmp + l, a + l, (r - l) * sizeof(int));
+        return;
+    }
+    int m = l + (r - l) / 2;
+    TaskGroup g = {0};
+    PMergeSortArgs left = {pool, a, tmp, l, m, !toTmp};
+    poolSubmit(pool, &g, pmsortTask, &left);
+    pmsort(pool, a, tmp, m, r, !toTmp);
+    poolWait(pool, &g);
+    int *src = toTmp ? a : tmp, *dst = toTmp ? tmp : a;
+    parallelMerge(pool, src + l, m - l, src + m, r - m, dst + l);
+}
+
+void parallelMergeSort(int arr[], int l, int r, ThreadPool *pool) {
+    int n = r - l + 1;
+    int *tmp = (n > 1) ? (int*)malloc(n * sizeof(int)) : NULL;
+    if (!pool || !tmp) {
+        free(tmp);
+        mergeSortBottomUp(arr + l, n, NULL);
+        return;
+    }
+    pmsort(pool, arr + l, tmp, 0, n, 0);
+    free(tmp);
+}
+
+typedef struct {
+    ThreadPool *pool;
+    int *arr;
+    int l, h, depth;
+} PQuickSortArgs;
+
+static void pqsort(ThreadPool *pool, int arr[], int l, int h, int depth);
+
+static void pqsortTask(void *p) {
+    PQuickSortArgs *s = (PQuickSortArgs*)p;
+    pqsort(s->pool, s->arr, s->l, s->h, s->depth);
+}
+
+// Spawns the smaller side and keeps partitioning the larger one; the depth
+// budget bounds both the fan-out and the degenerate-pivot case.
+static void pqsort(ThreadPool *pool, int arr[], int l, int h, int depth) {
+    PQuickSortArgs spawned[64];
+    int count = 0;
+    TaskGroup g = {0};
+    while (h - l + 1 > PAR_CUTOFF && depth > 0 && count < 64) {
+        depth--;
+        int m = choosePivot(arr, l, h);
+        int t = arr[m]; arr[m] = arr[h]; arr[h] = t;
+        int p = partition(arr, l, h);
+        if (p - l < h - p) {
+            spawned[count] = (PQuickSortArgs){pool, arr, l, p - 1, depth};
+            l = p + 1;
+        } else {
+            spawned[count] = (PQuickSortArgs){pool, arr, p + 1, h, depth};
+            h = p - 1;
+        }
+        poolSubmit(pool, &g, pqsortTask, &spawned[count++]);
+    }
+    if (l < h) introSort(arr, l, h);
+    poolWait(pool, &g);
+}
+
+void parallelQuickSort(int arr[], int l, int h, ThreadPool *pool) {
+    if (!pool) {
+        introSort(arr, l, h);
+        return;
+    }
+    int depth = 0;
+    for (int n = h - l + 1; n > 1; n >>= 1) depth += 2;
+    pqsort(pool, arr, l, h, depth);
+}
+
+// Sample Sort
+// Thread 0 sorts an oversampled random sample and lays the splitters out as
+// an implicit search tree. Every thread then classifies its chunk branch-free,
+// bucket offsets come from a prefix sum over the per-thread counts, the chunk
+// is scattered to a scratch buffer, and buckets are sorted with introSort,
+// handed out one at a time. Phase timings go to the optional stats struct.
+// A key common enough to be drawn as several splitters would swamp one
+// bucket, and one thread, so repeated splitters switch on equality buckets
+// (as in IPS4o): the tree is built over the distinct splitters, and keys
+// equal to their bucket's upper splitter go to a bucket of their own, which
+// needs no sorting.
+#define SAMPLE_OVERSAMPLE 16
+#define SAMPLE_MAX_BUCKETS 256
+
+typedef struct {
+    double sampleMs, classifyMs, scatterMs, sortMs;
+    int buckets, threads;
+} SampleSortStats;
+
+typedef struct {
+    int *a, *b;
+    unsigned char *bucketOf;
+    int n, threads, k, logK;
+    int buckets, eq;               // k, or 2k with equality buckets
+    int tree[SAMPLE_MAX_BUCKETS];  // splitters, 1-based implicit tree
+    int upper[SAMPLE_MAX_BUCKETS]; // upper splitter of each tree bucket
+    unsigned *cnt;                 // [thread][bucket] counts, then offsets
+    unsigned start[SAMPLE_MAX_BUCKETS + 1];
+    int nextBucket;
+    double stamp[3];
+    pthread_barrier_t barrier;
+    StartGate gate;  // see radixSortMT
+} SampleShared;
+
+typedef struct {
+    SampleShared *sh;
+    int id;
+} SampleWorker;
+
+static double nowMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+// In-order fill, so tree[1..k) is a binary search tree over the splitters.
+static int fillSplitterTree(int tree[], int node, int k, const int sp[], int idx) {
+    if (node >= k) return idx;
+    idx = fillSplitterTree(tree, 2 * node, k, sp, idx);
+    tree[node] = sp[idx++];
+    return fillSplitterTree(tree, 2 * node + 1, k, sp, idx);
+}
+
+static void* sampleWorker(void *arg) {
+    SampleWorker *w = (SampleWorker*)arg;
+    SampleShared *sh = w->sh;
+    gatePass(&sh->gate);
+    int t = w->id, k = sh->buckets;
+    long lo = (long)sh->n * t / sh->threads, hi = (long)sh->n * (t + 1) / sh->threads;
+    unsigned *cnt = sh->cnt + (long)t * k;
+
+    for (long i = lo; i < hi; i++) {
+        int x = sh->a[i], j = 1;
+        for (int l = 0; l < sh->logK; l++) j = 2 * j + (x > sh->tree[j]);
+        j -= sh->k;
+        if (sh->eq) j = 2 * j + (x == sh->upper[j]);
+        sh->bucketOf[i] = (unsigned char)j;
+        cnt[j]++;
+    }
+    pthread_barrier_wait(&sh->barrier);
+    if (t == 0) {
+        sh->stamp[0] = nowMs();
+        unsigned sum = 0;
+        for (int b = 0; b < k; b++) {
+            sh->start[b] = sum;
+            for (int u = 0; u < sh->threads; u++) {
+                unsigned c = sh->cnt[(long)u * k + b];
+                sh->cnt[(long)u * k + b] = sum;
+                sum += c;
+            }
+        }
+        sh->start[k] = sum;
+    }
+    pthread_barrier_wait(&sh->barrier);
+
+    for (long i = lo; i < hi; i++)
+        sh->b[cnt[sh->bucketOf[i]]++] = sh->a[i];
+    pthread_barrier_wait(&sh->barrier);
+    if (t == 0) sh->stamp[1] = nowMs();
+
+    int b;
+    while ((b = __atomic_fetch_add(&sh->nextBucket, 1, __ATOMIC_RELAXED)) < k) {
+        int len = sh->start[b + 1] - sh->start[b];
+        if (len > 1 && !(sh->eq && (b & 1))) introSort(sh->b + sh->start[b], 0, len - 1);
+        memcpy(sh->a + sh->start[b], sh->b + sh->start[b], len * sizeof(int));
+    }
+    return NULL;
+}
+
+void sampleSort(int arr[], int n, int threads, SampleSortStats *stats) {
+    double t0 = nowMs();
+    if (threads < 1) threads = 1;
+    if (stats) *stats = (SampleSortStats){0, 0, 0, 0, 0, threads};
+    if (n < (1 << 16)) {
+        if (n > 1) introSort(arr, 0, n - 1);
+        if (stats) stats->sortMs = nowMs() - t0;
+        return;
+    }
+    SampleShared *sh = (SampleShared*)calloc(1, sizeof(SampleShared));
+    int k = 2, logK = 1;
+    while (k < 4 * threads && k < SAMPLE_MAX_BUCKETS) {
+        k *= 2;
+        logK++;
+    }
+    int m = k * SAMPLE_OVERSAMPLE;
+    int *sample = (int*)malloc(m * sizeof(int));
+    pthread_t *tid = (pthread_t*)malloc(threads * sizeof(pthread_t));
+    SampleWorker *w = (SampleWorker*)malloc(threads * sizeof(SampleWorker));
+    if (sh) {
+        sh->b = (int*)malloc((size_t)n * sizeof(int));
+        sh->bucketOf = (unsigned char*)malloc(n);
+        sh->cnt = (unsigned*)calloc((size_t)threads * 2 * k, sizeof(unsigned));  // room for eq
+    }
+    if (!sh || !sample || !tid || !w || !sh->b || !sh->bucketOf || !sh->cnt) {
+        if (sh) { free(sh->b); free(sh->bucketOf); free(sh->cnt); }
+        free(sh); free(sample); free(tid); free(w);
+        introSort(arr, 0, n - 1);
+        return;
+    }
+
+    // Fixed-seed xorshift keeps the splitters, and so the run, reproducible.
+    unsigned x = 2463534242u;
+    for (int i = 0; i < m; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        sample[i] = arr[x % (unsigned)n];
+    }
+    introSort(sample, 0, m - 1);
+    int splitters[SAMPLE_MAX_BUCKETS], distinct = 0;
+    for (int i = 1; i < k; i++) {
+        int v = sample[i * SAMPLE_OVERSAMPLE];
+        if (distinct == 0 || splitters[distinct - 1] != v) splitters[distinct++] = v;
+    }
+    free(sample);
+    if (distinct < k - 1) {
+        // Keep every other distinct splitter until 2k buckets fit bucketOf.
+        while (distinct >= SAMPLE_MAX_BUCKETS / 2) {
+            for (int i = 0; 2 * i + 1 < distinct; i++) splitters[i] = splitters[2 * i + 1];
+            distinct /= 2;
+        }
+        for (k = 2, logK = 1; k <= distinct; k *= 2) logK++;
+        // Padding repeats the top splitter: its extra buckets stay empty.
+        for (int i = distinct; i < k - 1; i++) splitters[i] = splitters[distinct - 1];
+        sh->eq = 1;
+    }
+    fillSplitterTree(sh->tree, 1, k, splitters, 0);
+    memcpy(sh->upper, splitters, (k - 1) * sizeof(int));
+    sh->upper[k - 1] = splitters[k - 2];  // never equal: the last bucket is above it
+    sh->buckets = sh->eq ? 2 * k : k;
+
+    sh->a = arr;
+    sh->n = n;
+    sh->k = k;
+    sh->logK = logK;
+    sh->gate = (StartGate)START_GATE_INIT;
+    double t1 = nowMs();
+    for (int t = 0; t < threads; t++) w[t] = (SampleWorker){sh, t};
+    sh->threads = startTeam(tid, threads, sampleWorker, w, sizeof(SampleWorker));
+    pthread_barrier_init(&sh->barrier, NULL, sh->threads);
+    gateOpen(&sh->gate);
+    sampleWorker(&w[0]);
+    for (int t = 1; t < sh->threads; t++) pthread_join(tid[t], NULL);
+    double t2 = nowMs();
+
+    if (stats) {
+        stats->sampleMs = t1 - t0;
+        stats->classifyMs = sh->stamp[0] - t1;
+        stats->scatterMs = sh->stamp[1] - sh->stamp[0];
+        stats->sortMs = t2 - sh->stamp[1];
+        stats->buckets = sh->buckets;
+        stats->threads = sh->threads;
+    }
+    pthread_barrier_destroy(&sh->barrier);
+    free(sh->b); free(sh->bucketOf); free(sh->cnt);
+    free(sh); free(tid); free(w);
+}
+
+// Auto Sort
+// sortAuto() makes one pass over the input (AVX2 when available) for min,
+// max, descents and ascents, checks a strided sample for duplicates, and
+// dispatches on the first rule that holds:
+//   no descents                        -> nothing to do
+//   n <= SORTNET_MAX                   -> sortSmall
+//   max - min < n, table fits          -> countingSort
+//   descents or ascents < n / 16       -> timSort (a few long runs)
+//   n >= AUTO_RADIX_MIN                -> radixSort
+//   duplicate-heavy sample             -> quickSort3Way
+//   otherwise                          -> introSort
+// Radix stays ahead of the duplicate rule: from AUTO_RADIX_MIN up it beats
+// three-way partitioning even on 8 distinct wide-range keys. Below that,
+// many duplicates are what make introSort's partition() slow, so the
+// sample is taken for every n past the network.
+// sortAutoProfile() does the same and records the inputs and the choice.
+#define AUTO_RUN_DIV 16
+#define AUTO_RADIX_MIN (1 << 9)
+#define AUTO_COUNT_MAX (1 << 24)
+
+typedef struct {
+    int n, min, max;
+    long long descents, ascents;  // i with arr[i] > arr[i + 1], resp. <
+    int dupPairs;                 // equal neighbours in the sorted sample, -1 if not taken
+    const char *algorithm;
+    double profileMs, sortMs;
+} SortAutoStats;
+
+static void profileScalar(const int arr[], int n, SortAutoStats *st) {
+    int mn = arr[0], mx = arr[0];
+    long long desc = 0, asc = 0;
+    for (int i = 1; i < n; i++) {
+        if (arr[i] < mn) mn = arr[i];
+        if (arr[i] > mx) mx = arr[i];
+        desc += arr[i - 1] > arr[i];
+        asc += arr[i - 1] < arr[i];
+    }
+    st->min = mn; st->max = mx;
+    st->descents = desc; st->ascents = asc;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+// Compares each block of 8 with the block shifted by one; lane counters
+// cannot overflow since each sees at most n / 8 pairs.
+__attribute__((target("avx2")))
+static void profileAVX2(const int arr[], int n, SortAutoStats *st) {
+    __m256i mn = _mm256_set1_epi32(INT_MAX), mx = _mm256_set1_epi32(INT_MIN);
+    __m256i desc = _mm256_setzero_si256(), asc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 9 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(arr + i));
+        __m256i w = _mm256_loadu_si256((const __m256i*)(arr + i + 1));
+        mn = _mm256_min_epi32(mn, v);
+        mx = _mm256_max_epi32(mx, v);
+        desc = _mm256_sub_epi32(desc, _mm256_cmpgt_epi32(v, w));
+        asc = _mm256_sub_epi32(asc, _mm256_cmpgt_epi32(w, v));
+    }
+    int lo[8], hi[8], d[8], a[8];
+    _mm256_storeu_si256((__m256i*)lo, mn);
+    _mm256_storeu_si256((__m256i*)hi, mx);
+    _mm256_storeu_si256((__m256i*)d, desc);
+    _mm256_storeu_si256((__m256i*)a, asc);
+    profileScalar(arr + i, n - i, st);  // the pair (i - 1, i) was the last vector compare
+    for (int k = 0; k < 8; k++) {
+        if (lo[k] < st->min) st->min = lo[k];
+        if (hi[k] > st->max) st->max = hi[k];
+        st->descents += d[k];
+        st->ascents += a[k];
+    }
+}
+
+static void (*profileKernel)(const int[], int, SortAutoStats*) = profileScalar;
+static pthread_once_t profileOnce = PTHREAD_ONCE_INIT;
+
+static void profileInit(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) profileKernel = profileAVX2;
+}
+
+static void profileInput(const int arr[], int n, SortAutoStats *st) {
+    pthread_once(&profileOnce, profileInit);
+    profileKernel(arr, n, st);
+}
+#else
+static void profileInput(const int arr[], int n, SortAutoStats *st) {
+    profileScalar(arr, n, st);
+}
+#endif
+
+void sortAutoProfile(int arr[], int n, SortAutoStats *stats) {
+    SortAutoStats st = {0};
+    st.n = n;
+    st.dupPairs = -1;
+    st.algorithm = "none";
+    if (n < 1) {
+        if (stats) *stats = st;
+        return;
+    }
+    double t = nowMs();
+    profileInput(arr, n, &st);
+    if (n > SORTNET_MAX) st.dupPairs = sampleDuplicates(arr, 0, n - 1);
+    st.profileMs = nowMs() - t;
+
+    long long range = (long long)st.max - st.min + 1;
+    long long runs = st.descents < st.ascents ? st.descents : st.ascents;
+    t = nowMs();
+    if (st.descents == 0) {
+        st.algorithm = "none";  // already sorted
+    } else if (n <= SORTNET_MAX) {
+        st.algorithm = "sortSmall";
+        sortSmall(arr, n);
+    } else if (range <= n && range <= AUTO_COUNT_MAX) {
+        st.algorithm = "countingSort";
+        countingSort(arr, n, st.min, st.max);
+    } else if (runs < n / AUTO_RUN_DIV) {
+        st.algorithm = "timSort";
+        timSort(arr, n);
+    } else if (n >= AUTO_RADIX_MIN) {
+        st.algorithm = "radixSort";
+        radixSort(arr, n);
+    } else if (st.dupPairs >= DUP_SAMPLE / 8) {
+        st.algorithm = "quickSort3Way";
+        quickSort3Way(arr, 0, n - 1);
+    } else {
+        st.algorithm = "introSort";
+        introSort(arr, 0, n - 1);
+    }
+    st.sortMs = nowMs() - t;
+    if (stats) *stats = st;
+}
+
+void sortAuto(int arr[], int n) {
+    sortAutoProfile(arr, n, NULL);
 }
 
 // -----------------------------------------------------------------
@@ -115,6 +1891,8 @@ void heapSort(int arr[], int n) {
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include "pool.h"
+#include "out.h"
 
 // Basic node structure
 typedef struct Node {
@@ -131,6 +1909,15 @@ Node* createNode(int value) {
     return new;
 }
 
+// Create a node from a pool (see pool.h) - O(1)
+Node* createNodePooled(NodePool* pool, int value) {
+    Node* new = (Node*)poolAlloc(pool);
+    if (!new) return NULL;
+    new->data = value;
+    new->next = NULL;
+    return new;
+}
+
 // Insert at beginning - O(1)
 Node* insertFront(Node* head, int value) {
     Node* new = createNode(value);
@@ -223,18 +2010,23 @@ bool hasCycle(Node* head) {
     return false;
 }
 
-// Merge two sorted lists - O(n+m)
+// Merge two sorted lists - O(n+m), iterative so long lists can't overflow the stack
 Node* mergeSorted(Node* l1, Node* l2) {
-    if (!l1) return l2;
-    if (!l2) return l1;
+    Node dummy = {0, NULL};
+    Node* tail = &dummy;
 
-    if (l1->data <= l2->data) {
-        l1->next = mergeSorted(l1->next, l2);
-        return l1;
-    } else {
-        l2->next = mergeSorted(l1, l2->next);
-        return l2;
+    while (l1 && l2) {
+        if (l1->data <= l2->data) {
+            tail->next = l1;
+            l1 = l1->next;
+        } else {
+            tail->next = l2;
+            l2 = l2->next;
+        }
+        tail = tail->next;
     }
+    tail->next = l1 ? l1 : l2;
+    return dummy.next;
 }
 
 // Check if palindrome - O(n)
@@ -314,10 +2106,12 @@ Node* getNthFromEnd(Node* head, int n) {
 // Utility functions
 void printList(Node* head) {
     while (head) {
-        printf("%d -> ", head->data);
+        outInt(head->data);
+        outStr(" -> ");
         head = head->next;
     }
-    printf("NULL\n");
+    outStr("NULL\n");
+    outFlush();
 }
 
 int getLength(Node* head) {
@@ -339,6 +2133,17 @@ void freeList(Node* head) {
     }
 }
 
+// Return a pooled list's nodes to its pool - O(n)
+// If the pool holds nothing else, poolReset(pool) does the same in O(1).
+void freeListPooled(NodePool* pool, Node* head) {
+    Node* temp;
+    while (head) {
+        temp = head;
+        head = head->next;
+        poolFree(pool, temp);
+    }
+}
+
 // Rotate list by k positions - O(n)
 Node* rotateList(Node* head, int k) {
     if (!head || !head->next || k == 0) return head;
@@ -375,23 +2180,114 @@ Node* swapPairs(Node* head) {
     return temp;
 }
 
+// Sort list bottom-up - O(n log n), stable, O(1) stack
+// bucket[i] is empty or holds a sorted run of 2^i nodes. Each node is
+// carried up like a binary counter increment, merging with every full
+// bucket on the way, so no midpoint is ever searched for. Older runs are
+// always the left operand of mergeSorted, which keeps equal keys in order.
+#define LIST_SORT_BUCKETS 64
+
+Node* listSort(Node* head) {
+    Node* bucket[LIST_SORT_BUCKETS] = {NULL};
+    int used = 0;
+
+    while (head) {
+        Node* run = head;
+        head = head->next;
+        run->next = NULL;
+
+        int i = 0;
+        while (i < used && bucket[i]) {
+            run = mergeSorted(bucket[i], run);
+            bucket[i++] = NULL;
+        }
+        bucket[i] = run;
+        if (i == used) used++;
+    }
+
+    Node* result = NULL;
+    for (int i = 0; i < used; i++) {
+        if (bucket[i]) result = mergeSorted(bucket[i], result);
+    }
+    return result;
+}
+
 // Sort list using merge sort - O(n log n)
 Node* mergeSort(Node* head) {
+    return listSort(head);
+}
+
+// Sort list by gathering into an array - O(n)
+// One walk copies (key, node) pairs into an array, a stable LSD radix sort
+// (3 passes of 11 bits) orders them, and one pass relinks the nodes, so the
+// two list walks are the only pointer chasing. Falls back to listSort()
+// when memory runs out.
+#define GATHER_BITS 11
+#define GATHER_BUCKETS (1 << GATHER_BITS)
+
+typedef struct {
+    unsigned key;  // data with the sign bit flipped, so negatives sort first
+    Node* node;
+} NodeKey;
+
+Node* listSortGather(Node* head) {
     if (!head || !head->next) return head;
 
-    // Find middle
-    Node *slow = head, *fast = head->next;
-    while (fast && fast->next) {
-        slow = slow->next;
-        fast = fast->next->next;
+    int n = 0, cap = 1024;
+    NodeKey* src = (NodeKey*)malloc(cap * sizeof(NodeKey));
+    unsigned cnt[3][GATHER_BUCKETS] = {{0}};
+    for (Node* cur = head; cur && src; cur = cur->next) {
+        if (n == cap) {
+            NodeKey* grown = (NodeKey*)realloc(src, 2 * (size_t)cap * sizeof(NodeKey));
+            if (!grown) {
+                free(src);
+                src = NULL;
+                break;
+            }
+            src = grown;
+            cap *= 2;
+        }
+        unsigned k = (unsigned)cur->data ^ 0x80000000u;
+        src[n].key = k;
+        src[n++].node = cur;
+        for (int p = 0; p < 3; p++) cnt[p][(k >> (p * GATHER_BITS)) & (GATHER_BUCKETS - 1)]++;
+    }
+    NodeKey* dst = src ? (NodeKey*)malloc(n * sizeof(NodeKey)) : NULL;
+    if (!dst) {
+        free(src);
+        return listSort(head);
+    }
+
+    NodeKey *a = src, *b = dst;
+    for (int p = 0; p < 3; p++) {
+        int shift = p * GATHER_BITS;
+        unsigned* c = cnt[p];
+        if (c[(a[0].key >> shift) & (GATHER_BUCKETS - 1)] == (unsigned)n) continue;
+        unsigned sum = 0;
+        for (int d = 0; d < GATHER_BUCKETS; d++) {
+            unsigned t = c[d];
+            c[d] = sum;
+            sum += t;
+        }
+        for (int i = 0; i < n; i++) b[c[(a[i].key >> shift) & (GATHER_BUCKETS - 1)]++] = a[i];
+        NodeKey* t = a; a = b; b = t;
     }
 
-    // Split list
-    Node* right = slow->next;
-    slow->next = NULL;
+    for (int i = 0; i < n - 1; i++) a[i].node->next = a[i + 1].node;
+    a[n - 1].node->next = NULL;
+    head = a[0].node;
+    free(src);
+    free(dst);
+    return head;
+}
+
+// listSort() for short lists, listSortGather() from LIST_GATHER_MIN nodes
+#define LIST_GATHER_MIN 512
 
-    // Recursively sort and merge
-    return mergeSorted(mergeSort(head), mergeSort(right));
+Node* listSortHybrid(Node* head) {
+    int n = 0;
+    for (Node* cur = head; cur && n < LIST_GATHER_MIN; cur = cur->next) n++;
+    return n < LIST_GATHER_MIN ? listSort(head) : listSortGather(head);
 }
 
 // Add two numbers represented by linked lists - O(n)
@@ -463,23 +2359,22 @@ Node* partition(Node* head, int x) {
 void reorderList(Node* head) {
     if (!head || !head->next) return;
 
-    // Find middle
+    // Find middle; the first half keeps the extra node when n is odd
     Node *slow = head, *fast = head;
-    Node *prev = NULL;
-    while (fast && fast->next) {
+    while (fast->next && fast->next->next) {
         fast = fast->next->next;
-        prev = slow;
         slow = slow->next;
     }
-    prev->next = NULL;
+    Node* second = slow->next;
+    slow->next = NULL;
 
     // Reverse second half
     Node *l2 = NULL;
-    while (slow) {
-        Node* next = slow->next;
-        slow->next = l2;
-        l2 = slow;
-        slow = next;
+    while (second) {
+        Node* next = second->next;
+        second->next = l2;
+        l2 = second;
+        second = next;
     }
 
     // Merge lists
@@ -583,7 +2478,8 @@ Node* getTail(Node* head) {
     return head;
 }
 
-Node* partition(Node* head, Node* end, Node** newHead, Node** newEnd) {
+// Partition around the last node; named apart from partition() above
+Node* partitionLast(Node* head, Node* end, Node** newHead, Node** newEnd) {
     Node* pivot = end;
     Node *prev = NULL, *curr = head, *tail = pivot;
 
@@ -611,7 +2507,7 @@ Node* quickSortRecur(Node* head, Node* end) {
     if (!head || head == end) return head;
 
     Node *newHead = NULL, *newEnd = NULL;
-    Node* pivot = partition(head, end, &newHead, &newEnd);
+    Node* pivot = partitionLast(head, end, &newHead, &newEnd);
 
     if (newHead != pivot) {
         Node* tmp = newHead;
@@ -627,8 +2523,10 @@ Node* quickSortRecur(Node* head, Node* end) {
     return newHead;
 }
 
+// quickSortRecur() goes one level deep per node, and O(n^2), on sorted
+// input, so quickSort() is routed to listSort() like mergeSort()
 Node* quickSort(Node* head) {
-    return quickSortRecur(head, getTail(head));
+    return listSort(head);
 }
 
 // Utility: Print list with cycle (safe) - O(n)
@@ -640,22 +2538,176 @@ void printListSafe(Node* head) {
         // Check if node already visited
         for (int j = 0; j < i; j++) {
             if (visited[j] == head) {
-                printf(" -> [CYCLE]\n");
+                outStr(" -> [CYCLE]\n");
+                outFlush();
                 return;
             }
         }
 
         visited[i++] = head;
-        printf("%d -> ", head->data);
+        outInt(head->data);
+        outStr(" -> ");
         head = head->next;
     }
-    printf("NULL\n");
+    outStr("NULL\n");
+    outFlush();
+}
+
+// List handle: head, tail and size kept current by the list* functions, so
+// appends, length and tail lookups are O(1). head is an ordinary Node*
+// chain, so every function above still works on it; after changing the
+// chain through one of them, call listSync() to re-derive tail and size.
+typedef struct {
+    Node *head, *tail;
+    int size;
+} List;
+
+// Wrap an existing chain - O(n)
+List listFromNodes(Node* head) {
+    List list = {head, NULL, 0};
+    for (Node* cur = head; cur; cur = cur->next) {
+        list.tail = cur;
+        list.size++;
+    }
+    return list;
+}
+
+// Recompute tail and size after raw Node* edits - O(n)
+void listSync(List* list) {
+    *list = listFromNodes(list->head);
+}
+
+// Insert at beginning - O(1)
+bool listPushFront(List* list, int value) {
+    Node* new = createNode(value);
+    if (!new) return false;
+    new->next = list->head;
+    list->head = new;
+    if (!list->tail) list->tail = new;
+    list->size++;
+    return true;
+}
+
+// Insert at end - O(1)
+bool listPushBack(List* list, int value) {
+    Node* new = createNode(value);
+    if (!new) return false;
+    if (list->tail) list->tail->next = new;
+    else list->head = new;
+    list->tail = new;
+    list->size++;
+    return true;
+}
+
+// Remove the first node, storing its value in *value - O(1)
+bool listPopFront(List* list, int* value) {
+    Node* first = list->head;
+    if (!first) return false;
+    *value = first->data;
+    list->head = first->next;
+    if (!list->head) list->tail = NULL;
+    list->size--;
+    free(first);
+    return true;
+}
+
+// Insert at position (0..size) - O(position), O(1) at either end
+bool listInsertAt(List* list, int value, int position) {
+    if (position < 0 || position > list->size) return false;
+    if (position == 0) return listPushFront(list, value);
+    if (position == list->size) return listPushBack(list, value);
+
+    Node* current = list->head;
+    for (int i = 0; i < position - 1; i++) current = current->next;
+    Node* new = createNode(value);
+    if (!new) return false;
+    new->next = current->next;
+    current->next = new;
+    list->size++;
+    return true;
+}
+
+// Delete first occurrence of value - O(n)
+bool listDeleteValue(List* list, int value) {
+    Node dummy = {0, list->head};
+    Node* current = &dummy;
+    while (current->next && current->next->data != value) {
+        current = current->next;
+    }
+    if (!current->next) return false;
+
+    Node* temp = current->next;
+    current->next = temp->next;
+    if (temp == list->tail) list->tail = (current == &dummy) ? NULL : current;
+    list->head = dummy.next;
+    list->size--;
+    free(temp);
+    return true;
+}
+
+int listLength(const List* list) {
+    return list->size;
+}
+
+Node* listTail(const List* list) {
+    return list->tail;
+}
+
+// Get nth node from end (1-based) - one walk of size - n steps
+Node* listNthFromEnd(const List* list, int n) {
+    if (n < 1 || n > list->size) return NULL;
+    Node* current = list->head;
+    for (int i = 0; i < list->size - n; i++) current = current->next;
+    return current;
+}
+
+// Rotate right by k positions - one partial walk, no second pass
+void listRotate(List* list, int k) {
+    if (list->size < 2) return;
+    k %= list->size;
+    if (k < 0) k += list->size;
+    if (k == 0) return;
+
+    // The new tail sits size - k - 1 steps from the head.
+    Node* newTail = list->head;
+    for (int i = 0; i < list->size - k - 1; i++) newTail = newTail->next;
+    list->tail->next = list->head;
+    list->head = newTail->next;
+    newTail->next = NULL;
+    list->tail = newTail;
+}
+
+// Reverse list - O(n)
+void listReverse(List* list) {
+    list->tail = list->head;
+    list->head = reverse(list->head);
+}
+
+// Intersection point of two Y-shaped lists, using the cached lengths - O(n)
+Node* listIntersectionPoint(const List* a, const List* b) {
+    Node *p = a->head, *q = b->head;
+    for (int d = a->size - b->size; d > 0; d--) p = p->next;
+    for (int d = b->size - a->size; d > 0; d--) q = q->next;
+    while (p && p != q) {
+        p = p->next;
+        q = q->next;
+    }
+    return p;
+}
+
+// Free all nodes and reset the handle - O(n)
+void listClear(List* list) {
+    freeList(list->head);
+    list->head = list->tail = NULL;
+    list->size = 0;
 }
 
 // -----------------------------------------------------------------
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "pool.h"
+#include "out.h"
 
 typedef struct Node {
     int key;
@@ -710,6 +2762,34 @@ Node* insert(Node* root, int key) {
 }
 */
 
+// Creates a new node from a pool (see pool.h)
+// Complexity: O(1)
+Node* newNodePooled(NodePool* pool, int key) {
+    Node* node = (Node*)poolAlloc(pool);
+    if (!node) return NULL;
+    node->key = key;
+    node->p = node->left = node->right = NULL;
+    return node;
+}
+
+// Inserts a key into the BST, allocating from pool
+// Average Complexity: O(log n), Worst-case: O(n)
+Node* insertPooled(NodePool* pool, Node* root, int key) {
+    if (!root) return newNodePooled(pool, key);
+    if (key < root->key) root->left = insertPooled(pool, root->left, key);
+    else if (key > root->key) root->right = insertPooled(pool, root->right, key);
+    return root;
+}
+
+// Returns every node of a pooled tree to its pool
+// Complexity: O(n), or O(1) with poolReset(pool) if the pool holds only this tree
+void freeTreePooled(NodePool* pool, Node* root) {
+    if (!root) return;
+    freeTreePooled(pool, root->left);
+    freeTreePooled(pool, root->right);
+    poolFree(pool, root);
+}
+
 // Insert a node into binary tree (Level Order)
 // Complexity: O(n)
 Node* insertLevelOrder(Node* root, int key) {
@@ -860,29 +2940,47 @@ int size(Node* root) {
 
 // Traverses the BST in inorder
 // Complexity: O(n)
-void inorder(Node* root) {
+static void inorderOut(Node* root) {
     if (!root) return;
-    inorder(root->left);
-    printf("%d ", root->key);
-    inorder(root->right);
+    inorderOut(root->left);
+    outInt(root->key);
+    outStr(" ");
+    inorderOut(root->right);
+}
+
+void inorder(Node* root) {
+    inorderOut(root);
+    outFlush();
 }
 
 // Traverses the BST in preorder
 // Complexity: O(n)
-void preorder(Node* root) {
+static void preorderOut(Node* root) {
     if (!root) return;
-    printf("%d ", root->key);
-    preorder(root->left);
-    preorder(root->right);
+    outInt(root->key);
+    outStr(" ");
+    preorderOut(root->left);
+    preorderOut(root->right);
+}
+
+void preorder(Node* root) {
+    preorderOut(root);
+    outFlush();
 }
 
 // Traverses the BST in postorder
 // Complexity: O(n)
-void postorder(Node* root) {
+static void postorderOut(Node* root) {
     if (!root) return;
-    postorder(root->left);
-    postorder(root->right);
-    printf("%d ", root->key);
+    postorderOut(root->left);
+    postorderOut(root->right);
+    outInt(root->key);
+    outStr(" ");
+}
+
+void postorder(Node* root) {
+    postorderOut(root);
+    outFlush();
 }
 
 // BST to Inorder Array
@@ -1131,10 +3229,12 @@ void levelOrder(Node* root) {
 
     while (front < rear) {
         Node* curr = queue[front++];
-        printf("%d ", curr->key);
+        outInt(curr->key);
+        outStr(" ");
         if (curr->left) queue[rear++] = curr->left;
         if (curr->right) queue[rear++] = curr->right;
     }
+    outFlush();
     free(queue);
 }
 
@@ -1303,7 +3403,8 @@ void dfs(Node* root) {
     
     while (top >= 0) {
         Node* current = stack[top--];
-        printf("%d ", current->key);
+        outInt(current->key);
+        outStr(" ");
         
         // Push right child first so that left is processed first
         if (current->right)
@@ -1317,6 +3418,7 @@ void dfs(Node* root) {
             stack = realloc(stack, capacity * sizeof(Node*));
         }
     }
+    outFlush();
     free(stack);
 }
 
@@ -1354,9 +3456,11 @@ void printPathsUtil(Node* root, int path[], int pathLen) {
     // If it's a leaf, print the path
     if (!root->left && !root->right) {
         for (int i = 0; i < pathLen; i++) {
-            printf("%d ", path[i]);
+            outInt(path[i]);
+            outStr(" ");
         }
-        printf("\n");
+        outStr("\n");
+        outFlush();
     } else {
         printPathsUtil(root->left, path, pathLen);
         printPathsUtil(root->right, path, pathLen);
@@ -1519,9 +3623,12 @@ void pathSumUtil(Node* root, int sum, int path[], int pathLen) {
     path[pathLen++] = root->key;
     sum -= root->key;
     if (!root->left && !root->right && sum == 0) {
-        for (int i = 0; i < pathLen; i++)
-            printf("%d ", path[i]);
-        printf("\n");
+        for (int i = 0; i < pathLen; i++) {
+            outInt(path[i]);
+            outStr(" ");
+        }
+        outStr("\n");
+        outFlush();
     } else {
         pathSumUtil(root->left, sum, path, pathLen);
         pathSumUtil(root->right, sum, path, pathLen);
@@ -1539,9 +3646,12 @@ void printPaths(Node* root, int path[], int pathLen) {
     if (!root) return;
     path[pathLen++] = root->key;
     if (!root->left && !root->right) {
-        for (int i = 0; i < pathLen; i++)
-            printf("%d ", path[i]);
-        printf("\n");
+        for (int i = 0; i < pathLen; i++) {
+            outInt(path[i]);
+            outStr(" ");
+        }
+        outStr("\n");
+        outFlush();
     } else {
         printPaths(root->left, path, pathLen);
         printPaths(root->right, path, pathLen);
@@ -0,0 +1,93 @@
+#ifndef OUT_H
+#define OUT_H
+#include <stdio.h>
+#include <string.h>
+
+// --- Buffered Output ---
+// The print and display functions format into a per-thread buffer instead
+// of calling printf once per element. Integers are formatted two digits at
+// a time from a digit-pair table. outFlush() hands the buffer to stdout
+// with a single fwrite at the end of each print function, so the output
+// still interleaves correctly with plain printf calls around it.
+// In binary mode, outInt() writes each value as 4 little-endian bytes and
+// outStr() writes nothing, so a print function dumps just the raw values.
+// The mode and the buffer are per thread and per translation unit.
+//
+//   outSetBinary(1); printList(head); outSetBinary(0);
+
+#define OUT_BUF_BYTES (32 * 1024)
+
+typedef struct {
+    size_t len;
+    int binary;
+    char buf[OUT_BUF_BYTES];
+} OutWriter;
+
+static _Thread_local OutWriter outWriter;
+
+static const char outDigitPairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static inline void outFlush(void) {
+    if (outWriter.len) fwrite(outWriter.buf, 1, outWriter.len, stdout);
+    outWriter.len = 0;
+}
+
+static inline void outSetBinary(int on) {
+    outFlush();
+    outWriter.binary = on;
+}
+
+// Makes room for n more bytes (n <= OUT_BUF_BYTES).
+static inline char* outReserve(size_t n) {
+    if (outWriter.len + n > OUT_BUF_BYTES) outFlush();
+    return outWriter.buf + outWriter.len;
+}
+
+static inline void outInt(int value) {
+    if (outWriter.binary) {
+        unsigned u = (unsigned)value;
+        unsigned char* p = (unsigned char*)outReserve(4);
+        p[0] = u & 0xff;
+        p[1] = (u >> 8) & 0xff;
+        p[2] = (u >> 16) & 0xff;
+        p[3] = u >> 24;
+        outWriter.len += 4;
+        return;
+    }
+    // Digits are produced backwards into tmp, two per division.
+    char tmp[12], *end = tmp + sizeof(tmp), *p = end;
+    unsigned u = value < 0 ? 0u - (unsigned)value : (unsigned)value;
+    while (u >= 100) {
+        unsigned r = u % 100;
+        u /= 100;
+        p -= 2;
+        memcpy(p, outDigitPairs + 2 * r, 2);
+    }
+    if (u >= 10) {
+        p -= 2;
+        memcpy(p, outDigitPairs + 2 * u, 2);
+    } else {
+        *--p = (char)('0' + u);
+    }
+    if (value < 0) *--p = '-';
+    size_t n = end - p;
+    memcpy(outReserve(n), p, n);
+    outWriter.len += n;
+}
+
+static inline void outStr(const char* s) {
+    if (outWriter.binary) return;
+    size_t n = strlen(s);
+    if (n > OUT_BUF_BYTES) {
+        outFlush();
+        fwrite(s, 1, n, stdout);
+        return;
+    }
+    memcpy(outReserve(n), s, n);
+    outWriter.len += n;
+}
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef POOL_H
+#define POOL_H
+#include <stdlib.h>
+#include <string.h>
+
+// --- Node Pool ---
+// Fixed-size slots carved from 64 KiB chunks instead of one malloc per node.
+// Freed slots go on the pool's free list and are handed out first.
+// poolReset() drops every slot at once in O(1) by rewinding to the first
+// chunk, so a whole list or tree built from a pool is released without
+// walking it; the chunks are kept for reuse until freePool(). In arena mode
+// poolFree() does nothing and memory only comes back on reset.
+// A pool has no lock: use one per thread, or poolDefault(), which gives
+// each thread its own pool per size class.
+//
+//   NodePool* pool = createPool(sizeof(Node), 0);
+//   Node* n = poolAlloc(pool);  ...  poolFree(pool, n);
+//   poolReset(pool);            // everything allocated so far is gone
+//   freePool(pool);
+
+#define POOL_ALIGN 16
+#define POOL_CHUNK_BYTES (64 * 1024)
+#define POOL_CLASSES 8  // default size classes: 16, 32, ..., 128 bytes
+
+typedef struct PoolSlot {
+    struct PoolSlot* next;
+} PoolSlot;
+
+typedef struct PoolChunk {
+    struct PoolChunk* next;
+} PoolChunk;
+
+typedef struct {
+    size_t slotSize;
+    int arena;
+    PoolChunk *chunks, *cur, *tail;  // cur is the chunk being carved
+    char *bump, *end;                // unused part of cur
+    PoolSlot* freeList;
+    // Counters: slots handed out and returned, slots in use, chunks held.
+    size_t allocs, frees, live, chunkCount;
+} NodePool;
+
+// Rounds size up to its class, a multiple of POOL_ALIGN.
+static inline size_t poolSizeClass(size_t size) {
+    if (size < sizeof(PoolSlot)) size = sizeof(PoolSlot);
+    return (size + POOL_ALIGN - 1) & ~(size_t)(POOL_ALIGN - 1);
+}
+
+static inline void poolInit(NodePool* pool, size_t size, int arena) {
+    memset(pool, 0, sizeof(*pool));
+    pool->slotSize = poolSizeClass(size);
+    pool->arena = arena;
+}
+
+static inline NodePool* createPool(size_t size, int arena) {
+    if (poolSizeClass(size) > POOL_CHUNK_BYTES - POOL_ALIGN) return NULL;
+    NodePool* pool = (NodePool*)malloc(sizeof(NodePool));
+    if (!pool) return NULL;
+    poolInit(pool, size, arena);
+    return pool;
+}
+
+// Moves to the next kept chunk, or mallocs one; returns 0 when out of memory.
+static inline int poolGrow(NodePool* pool) {
+    if (pool->cur && pool->cur->next) {
+        pool->cur = pool->cur->next;
+    } else {
+        PoolChunk* c = (PoolChunk*)malloc(POOL_CHUNK_BYTES);
+        if (!c) return 0;
+        c->next = NULL;
+        if (pool->tail) pool->tail->next = c;
+        else pool->chunks = c;
+        pool->tail = pool->cur = c;
+        pool->chunkCount++;
+    }
+    pool->bump = (char*)pool->cur + POOL_ALIGN;
+    pool->end = (char*)pool->cur + POOL_CHUNK_BYTES;
+    return 1;
+}
+
+static inline void* poolAlloc(NodePool* pool) {
+    void* p;
+    if (pool->freeList) {
+        p = pool->freeList;
+        pool->freeList = pool->freeList->next;
+    } else {
+        if ((size_t)(pool->end - pool->bump) < pool->slotSize && !poolGrow(pool)) return NULL;
+        p = pool->bump;
+        pool->bump += pool->slotSize;
+    }
+    pool->allocs++;
+    pool->live++;
+    return p;
+}
+
+static inline void poolFree(NodePool* pool, void* p) {
+    if (!p || pool->arena) return;
+    PoolSlot* s = (PoolSlot*)p;
+    s->next = pool->freeList;
+    pool->freeList = s;
+    pool->frees++;
+    pool->live--;
+}
+
+// Releases every slot in O(1); the chunks stay allocated for reuse.
+static inline void poolReset(NodePool* pool) {
+    pool->cur = NULL;
+    pool->bump = pool->end = NULL;
+    pool->freeList = NULL;
+    pool->live = 0;
+    if (pool->chunks) {
+        pool->cur = pool->chunks;
+        pool->bump = (char*)pool->chunks + POOL_ALIGN;
+        pool->end = (char*)pool->chunks + POOL_CHUNK_BYTES;
+    }
+}
+
+// Returns the chunks to malloc; the pool itself stays usable.
+static inline void poolRelease(NodePool* pool) {
+    while (pool->chunks) {
+        PoolChunk* next = pool->chunks->next;
+        free(pool->chunks);
+        pool->chunks = next;
+    }
+    poolInit(pool, pool->slotSize, pool->arena);
+}
+
+static inline void freePool(NodePool* pool) {
+    if (!pool) return;
+    poolRelease(pool);
+    free(pool);
+}
+
+// Per-thread pool for the size class of size, or NULL above the largest class.
+static _Thread_local NodePool poolThreadPools[POOL_CLASSES];
+
+static inline NodePool* poolDefault(size_t size) {
+    size_t cls = poolSizeClass(size) / POOL_ALIGN - 1;
+    if (cls >= POOL_CLASSES) return NULL;
+    NodePool* pool = &poolThreadPools[cls];
+    if (!pool->slotSize) poolInit(pool, (cls + 1) * POOL_ALIGN, 0);
+    return pool;
+}
+
+// Frees the calling thread's default pools; call before the thread exits.
+static inline void poolReleaseThread(void) {
+    for (int i = 0; i < POOL_CLASSES; i++)
+        if (poolThreadPools[i].slotSize) poolRelease(&poolThreadPools[i]);
+}
+
+#endif
@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <limits.h>
+#include "pool.h"
+#include "out.h"
 
 // Array-based Queue
 
@@ -42,7 +44,10 @@ void enqueue(Queue* queue, int item) {
     queue->rear = (queue->rear + 1) % queue->capacity;
     queue->array[queue->rear] = item;
     queue->size++;
-    printf("Enqueued %d\n", item);
+    outStr("Enqueued ");
+    outInt(item);
+    outStr("\n");
+    outFlush();
 }
 
 int dequeue(Queue* queue) {
@@ -74,12 +79,14 @@ void displayQueue(Queue* queue) {
         printf("Queue is empty.\n");
         return;
     }
-    printf("Queue: ");
+    outStr("Queue: ");
     for (unsigned i = 0, idx = queue->front; i < queue->size; i++) {
-        printf("%d ", queue->array[idx]);
+        outInt(queue->array[idx]);
+        outStr(" ");
         idx = (idx + 1) % queue->capacity;
     }
-    printf("\n");
+    outStr("\n");
+    outFlush();
 }
 
 // Search for an element in the queue. Returns index or -1 if not found.
@@ -154,37 +161,66 @@ LLQueue* createLLQueue() {
     return q;
 }
 
-// Enqueue for linked list based queue.
-void llEnqueue(LLQueue *q, int item) {
-    Node* temp = (Node*) malloc(sizeof(Node));
-    if (!temp) return;
+// Link a new node holding item at the rear.
+static void llLinkRear(LLQueue *q, Node* temp, int item) {
     temp->data = item;
     temp->next = NULL;
     if (q->rear == NULL) {
         q->front = q->rear = temp;
-        printf("Enqueued %d in LLQueue\n", item);
-        return;
+    } else {
+        q->rear->next = temp;
+        q->rear = temp;
     }
-    q->rear->next = temp;
-    q->rear = temp;
-    printf("Enqueued %d in LLQueue\n", item);
+    outStr("Enqueued ");
+    outInt(item);
+    outStr(" in LLQueue\n");
+    outFlush();
 }
 
-// Dequeue for linked list based queue.
-int llDequeue(LLQueue *q) {
+// Unlink the front node, or NULL if the queue is empty.
+static Node* llUnlinkFront(LLQueue *q) {
     if (q->front == NULL) {
         printf("Linked List Queue is empty.\n");
-        return INT_MIN;
+        return NULL;
     }
     Node* temp = q->front;
-    int item = temp->data;
     q->front = q->front->next;
     if (q->front == NULL)
         q->rear = NULL;
+    return temp;
+}
+
+// Enqueue for linked list based queue.
+void llEnqueue(LLQueue *q, int item) {
+    Node* temp = (Node*) malloc(sizeof(Node));
+    if (!temp) return;
+    llLinkRear(q, temp, item);
+}
+
+// Dequeue for linked list based queue.
+int llDequeue(LLQueue *q) {
+    Node* temp = llUnlinkFront(q);
+    if (!temp) return INT_MIN;
+    int item = temp->data;
     free(temp);
     return item;
 }
 
+// Pool-backed enqueue/dequeue (see pool.h); a queue must stick to one pair.
+void llEnqueuePooled(NodePool *pool, LLQueue *q, int item) {
+    Node* temp = (Node*) poolAlloc(pool);
+    if (!temp) return;
+    llLinkRear(q, temp, item);
+}
+
+int llDequeuePooled(NodePool *pool, LLQueue *q) {
+    Node* temp = llUnlinkFront(q);
+    if (!temp) return INT_MIN;
+    int item = temp->data;
+    poolFree(pool, temp);
+    return item;
+}
+
 // Get front of linked list queue.
 int llFront(LLQueue *q) {
     if (q->front == NULL)
@@ -198,13 +234,15 @@ void displayLLQueue(LLQueue *q) {
         printf("Linked List Queue is empty.\n");
         return;
     }
-    printf("LLQueue: ");
+    outStr("LLQueue: ");
     Node* temp = q->front;
     while (temp) {
-        printf("%d ", temp->data);
+        outInt(temp->data);
+        outStr(" ");
         temp = temp->next;
     }
-    printf("\n");
+    outStr("\n");
+    outFlush();
 }
 
 // Search for an element in the linked list queue.
@@ -231,6 +269,18 @@ void clearLLQueue(LLQueue *q) {
     printf("LLQueue cleared.\n");
 }
 
+// Clear a pooled linked list queue. If the pool holds nothing else,
+// poolReset(pool) followed by q->front = q->rear = NULL is O(1).
+void clearLLQueuePooled(NodePool *pool, LLQueue *q) {
+    while (q->front) {
+        Node* temp = q->front;
+        q->front = q->front->next;
+        poolFree(pool, temp);
+    }
+    q->rear = NULL;
+    printf("LLQueue cleared.\n");
+}
+
 // Free memory allocated for the linked list queue.
 void freeLLQueue(LLQueue *q) {
     clearLLQueue(q);
@@ -0,0 +1,298 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "out.h"
+
+// Skip list: a sorted set of ints with O(log n) expected insert, delete,
+// contains and rank, in place of a sorted ll.c list where all of those are
+// O(n). Each node carries a tower of 1..SKIP_MAX_LEVEL forward links stored
+// inline after the value, so a node is one allocation sized to its own
+// height. Tower heights are random with P(level > k) = 4^-k, which gives
+// about 1.33 links per node. Every link also records its span (how many
+// level-0 steps it skips), which is what makes rank and select O(log n).
+//
+// A list created with shared = true takes a pthread rwlock around every
+// operation: any number of readers (contains, rank, select, range scans)
+// run together, and a writer (insert, delete) runs alone.
+#define SKIP_MAX_LEVEL 16
+
+typedef struct SkipNode SkipNode;
+
+typedef struct {
+    SkipNode* next;
+    int span;
+} SkipLink;
+
+struct SkipNode {
+    int data;
+    int level;
+    SkipLink link[];
+};
+
+typedef struct {
+    SkipNode* head;  // sentinel with SKIP_MAX_LEVEL links
+    int level, size;
+    unsigned rng;
+    bool shared;
+    pthread_rwlock_t lock;
+} SkipList;
+
+static SkipNode* createSkipNode(int value, int level) {
+    SkipNode* new = (SkipNode*)malloc(sizeof(SkipNode) + level * sizeof(SkipLink));
+    if (!new) return NULL;
+    new->data = value;
+    new->level = level;
+    for (int i = 0; i < level; i++) {
+        new->link[i].next = NULL;
+        new->link[i].span = 0;
+    }
+    return new;
+}
+
+SkipList* createSkipList(bool shared) {
+    SkipList* list = (SkipList*)malloc(sizeof(SkipList));
+    if (!list) return NULL;
+    list->head = createSkipNode(0, SKIP_MAX_LEVEL);
+    if (!list->head) {
+        free(list);
+        return NULL;
+    }
+    list->level = 1;
+    list->size = 0;
+    list->rng = 2463534242u;
+    list->shared = shared;
+    if (shared && pthread_rwlock_init(&list->lock, NULL) != 0) {
+        free(list->head);
+        free(list);
+        return NULL;
+    }
+    return list;
+}
+
+static void readLock(SkipList* list) {
+    if (list->shared) pthread_rwlock_rdlock(&list->lock);
+}
+
+static void writeLock(SkipList* list) {
+    if (list->shared) pthread_rwlock_wrlock(&list->lock);
+}
+
+static void unlock(SkipList* list) {
+    if (list->shared) pthread_rwlock_unlock(&list->lock);
+}
+
+// Two random bits per level: trailing zero pairs of an xorshift draw.
+static int randomLevel(SkipList* list) {
+    unsigned x = list->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    list->rng = x;
+    return 1 + __builtin_ctz(x | (1u << (2 * (SKIP_MAX_LEVEL - 1)))) / 2;
+}
+
+// Insert value; false if already present or out of memory - O(log n)
+bool skipInsert(SkipList* list, int value) {
+    SkipNode* update[SKIP_MAX_LEVEL];
+    int rank[SKIP_MAX_LEVEL];  // level-0 position of update[i]
+
+    writeLock(list);
+    SkipNode* x = list->head;
+    for (int i = list->level - 1; i >= 0; i--) {
+        rank[i] = (i == list->level - 1) ? 0 : rank[i + 1];
+        while (x->link[i].next && x->link[i].next->data < value) {
+            rank[i] += x->link[i].span;
+            x = x->link[i].next;
+        }
+        update[i] = x;
+    }
+    if (x->link[0].next && x->link[0].next->data == value) {
+        unlock(list);
+        return false;
+    }
+
+    int level = randomLevel(list);
+    SkipNode* new = createSkipNode(value, level);
+    if (!new) {
+        unlock(list);
+        return false;
+    }
+    for (int i = list->level; i < level; i++) {
+        rank[i] = 0;
+        update[i] = list->head;
+        update[i]->link[i].span = list->size;
+    }
+    if (level > list->level) list->level = level;
+
+    for (int i = 0; i < level; i++) {
+        new->link[i].next = update[i]->link[i].next;
+        update[i]->link[i].next = new;
+        new->link[i].span = update[i]->link[i].span - (rank[0] - rank[i]);
+        update[i]->link[i].span = rank[0] - rank[i] + 1;
+    }
+    // Links above the new tower now jump over one more node.
+    for (int i = level; i < list->level; i++) update[i]->link[i].span++;
+    list->size++;
+    unlock(list);
+    return true;
+}
+
+// Delete value; false if not present - O(log n)
+bool skipDelete(SkipList* list, int value) {
+    SkipNode* update[SKIP_MAX_LEVEL];
+
+    writeLock(list);
+    SkipNode* x = list->head;
+    for (int i = list->level - 1; i >= 0; i--) {
+        while (x->link[i].next && x->link[i].next->data < value) x = x->link[i].next;
+        update[i] = x;
+    }
+    x = x->link[0].next;
+    if (!x || x->data != value) {
+        unlock(list);
+        return false;
+    }
+
+    for (int i = 0; i < list->level; i++) {
+        if (update[i]->link[i].next == x) {
+            update[i]->link[i].span += x->link[i].span - 1;
+            update[i]->link[i].next = x->link[i].next;
+        } else {
+            update[i]->link[i].span--;
+        }
+    }
+    while (list->level > 1 && !list->head->link[list->level - 1].next) list->level--;
+    list->size--;
+    free(x);
+    unlock(list);
+    return true;
+}
+
+// Last node with data < value, or the head - O(log n)
+static SkipNode* findLess(SkipList* list, int value) {
+    SkipNode* x = list->head;
+    for (int i = list->level - 1; i >= 0; i--) {
+        while (x->link[i].next && x->link[i].next->data < value) x = x->link[i].next;
+    }
+    return x;
+}
+
+bool skipContains(SkipList* list, int value) {
+    readLock(list);
+    SkipNode* x = findLess(list, value)->link[0].next;
+    bool found = x && x->data == value;
+    unlock(list);
+    return found;
+}
+
+// 1-based position of value in sorted order, or 0 if absent - O(log n)
+int skipRank(SkipList* list, int value) {
+    readLock(list);
+    SkipNode* x = list->head;
+    int rank = 0;
+    for (int i = list->level - 1; i >= 0; i--) {
+        while (x->link[i].next && x->link[i].next->data <= value) {
+            rank += x->link[i].span;
+            x = x->link[i].next;
+        }
+    }
+    if (x == list->head || x->data != value) rank = 0;
+    unlock(list);
+    return rank;
+}
+
+// Store the k-th smallest value (1-based) in *value - O(log n)
+bool skipSelect(SkipList* list, int k, int* value) {
+    readLock(list);
+    bool found = false;
+    if (k >= 1 && k <= list->size) {
+        SkipNode* x = list->head;
+        int traversed = 0;
+        for (int i = list->level - 1; i >= 0; i--) {
+            while (x->link[i].next && traversed + x->link[i].span <= k) {
+                traversed += x->link[i].span;
+                x = x->link[i].next;
+            }
+        }
+        *value = x->data;
+        found = true;
+    }
+    unlock(list);
+    return found;
+}
+
+int skipLength(SkipList* list) {
+    readLock(list);
+    int size = list->size;
+    unlock(list);
+    return size;
+}
+
+// Range iterator over [lo, hi]: one O(log n) descent to lo, then a walk
+// along level 0. In shared mode it holds the read lock from skipIterInit()
+// to skipIterDone(), so writers wait for it and the same thread must not
+// insert or delete in between.
+//
+//   SkipIter it;
+//   int v;
+//   skipIterInit(&it, list, lo, hi);
+//   while (skipIterNext(&it, &v)) ...;
+//   skipIterDone(&it);
+typedef struct {
+    SkipList* list;
+    SkipNode* cur;
+    int hi;
+} SkipIter;
+
+void skipIterInit(SkipIter* it, SkipList* list, int lo, int hi) {
+    readLock(list);
+    it->list = list;
+    it->cur = findLess(list, lo)->link[0].next;
+    it->hi = hi;
+}
+
+bool skipIterNext(SkipIter* it, int* value) {
+    if (!it->cur || it->cur->data > it->hi) return false;
+    *value = it->cur->data;
+    it->cur = it->cur->link[0].next;
+    return true;
+}
+
+void skipIterDone(SkipIter* it) {
+    unlock(it->list);
+}
+
+// Copy up to max values in [lo, hi] into out; returns how many were copied
+int skipRange(SkipList* list, int lo, int hi, int out[], int max) {
+    SkipIter it;
+    int count = 0;
+    skipIterInit(&it, list, lo, hi);
+    while (count < max && skipIterNext(&it, &out[count])) count++;
+    skipIterDone(&it);
+    return count;
+}
+
+// Utility functions
+void printSkipList(SkipList* list) {
+    readLock(list);
+    for (SkipNode* x = list->head->link[0].next; x; x = x->link[0].next) {
+        outInt(x->data);
+        outStr(" -> ");
+    }
+    outStr("NULL\n");
+    outFlush();
+    unlock(list);
+}
+
+void freeSkipList(SkipList* list) {
+    if (!list) return;
+    SkipNode *x = list->head, *temp;
+    while (x) {
+        temp = x;
+        x = x->link[0].next;
+        free(temp);
+    }
+    if (list->shared) pthread_rwlock_destroy(&list->lock);
+    free(list);
+}
@@ -0,0 +1,268 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "out.h"
+
+// Index-based linked list: nodes are slots in two parallel arrays, data[]
+// and next[], and a link is a 32-bit slot index instead of a pointer. A
+// node costs 8 bytes instead of the 16 of ll.c's padded Node. Nodes live
+// side by side rather than scattered over the heap, and a list built by
+// listFromArray() occupies consecutive slots, so walking it is a linear
+// scan the hardware prefetcher can follow.
+// Lists are identified by the index of their head (IDX_NIL when empty) and
+// belong to an IdxPool, which any number of lists can share. Freed slots
+// form a stack threaded through next[] and are reused first. The arrays
+// grow by doubling; indices stay valid when they do, pointers into them
+// do not.
+#define IDX_NIL UINT32_MAX
+
+typedef uint32_t Idx;
+
+typedef struct {
+    int* data;
+    Idx* next;
+    Idx freeTop;              // top of the free-slot stack
+    uint32_t used, capacity;  // slots ever handed out, slots allocated
+} IdxPool;
+
+IdxPool* createIdxPool(uint32_t capacity) {
+    IdxPool* pool = (IdxPool*)malloc(sizeof(IdxPool));
+    if (!pool) return NULL;
+    if (capacity < 16) capacity = 16;
+    pool->data = (int*)malloc(capacity * sizeof(int));
+    pool->next = (Idx*)malloc(capacity * sizeof(Idx));
+    if (!pool->data || !pool->next) {
+        free(pool->data);
+        free(pool->next);
+        free(pool);
+        return NULL;
+    }
+    pool->freeTop = IDX_NIL;
+    pool->used = 0;
+    pool->capacity = capacity;
+    return pool;
+}
+
+// Make room for extra fresh slots; false if out of memory or indices
+static bool idxReserve(IdxPool* pool, uint32_t extra) {
+    if (extra > IDX_NIL - pool->used) return false;
+    uint64_t need = (uint64_t)pool->used + extra, cap = pool->capacity;
+    if (need <= cap) return true;
+    while (cap < need) cap *= 2;
+    if (cap > IDX_NIL) cap = IDX_NIL;
+
+    int* data = (int*)realloc(pool->data, cap * sizeof(int));
+    if (!data) return false;
+    pool->data = data;
+    Idx* next = (Idx*)realloc(pool->next, cap * sizeof(Idx));
+    if (!next) return false;
+    pool->next = next;
+    pool->capacity = (uint32_t)cap;
+    return true;
+}
+
+// Create a new node; IDX_NIL if out of memory
+Idx idxAlloc(IdxPool* pool, int value) {
+    Idx i = pool->freeTop;
+    if (i != IDX_NIL) {
+        pool->freeTop = pool->next[i];
+    } else {
+        if (!idxReserve(pool, 1)) return IDX_NIL;
+        i = pool->used++;
+    }
+    pool->data[i] = value;
+    pool->next[i] = IDX_NIL;
+    return i;
+}
+
+void idxFree(IdxPool* pool, Idx i) {
+    pool->next[i] = pool->freeTop;
+    pool->freeTop = i;
+}
+
+// Free entire list - O(n)
+void idxFreeList(IdxPool* pool, Idx head) {
+    while (head != IDX_NIL) {
+        Idx next = pool->next[head];
+        idxFree(pool, head);
+        head = next;
+    }
+}
+
+void freeIdxPool(IdxPool* pool) {
+    if (!pool) return;
+    free(pool->data);
+    free(pool->next);
+    free(pool);
+}
+
+// Bulk conversions
+
+// Build a list of arr[0..n-1] - O(n). Freed slots are reused first; the
+// rest of the list takes one run of consecutive fresh slots.
+Idx listFromArray(IdxPool* pool, const int arr[], uint32_t n) {
+    Idx head = IDX_NIL, tail = IDX_NIL;
+    uint32_t i = 0;
+    for (; i < n && pool->freeTop != IDX_NIL; i++) {
+        Idx new = idxAlloc(pool, arr[i]);
+        if (tail == IDX_NIL) head = new;
+        else pool->next[tail] = new;
+        tail = new;
+    }
+    if (i == n) return head;
+    if (!idxReserve(pool, n - i)) {
+        idxFreeList(pool, head);
+        return IDX_NIL;
+    }
+
+    Idx first = pool->used, last = first + (n - i) - 1;
+    memcpy(pool->data + first, arr + i, (n - i) * sizeof(int));
+    for (Idx j = first; j < last; j++) pool->next[j] = j + 1;
+    pool->next[last] = IDX_NIL;
+    pool->used += n - i;
+    if (tail == IDX_NIL) return first;
+    pool->next[tail] = first;
+    return head;
+}
+
+// Copy up to max values into out; returns how many were copied - O(n)
+uint32_t listToArray(const IdxPool* pool, Idx head, int out[], uint32_t max) {
+    uint32_t count = 0;
+    for (; head != IDX_NIL && count < max; head = pool->next[head]) {
+        out[count++] = pool->data[head];
+    }
+    return count;
+}
+
+// Operations, ported from ll.c
+
+// Insert at beginning - O(1)
+Idx idxInsertFront(IdxPool* pool, Idx head, int value) {
+    Idx new = idxAlloc(pool, value);
+    if (new == IDX_NIL) return head;
+    pool->next[new] = head;
+    return new;
+}
+
+// Delete first occurrence of value - O(n)
+Idx idxDeleteValue(IdxPool* pool, Idx head, int value) {
+    Idx prev = IDX_NIL, current = head;
+    while (current != IDX_NIL && pool->data[current] != value) {
+        prev = current;
+        current = pool->next[current];
+    }
+    if (current == IDX_NIL) return head;
+
+    if (prev == IDX_NIL) head = pool->next[current];
+    else pool->next[prev] = pool->next[current];
+    idxFree(pool, current);
+    return head;
+}
+
+// Reverse list - O(n)
+Idx idxReverse(IdxPool* pool, Idx head) {
+    Idx prev = IDX_NIL, current = head, next;
+    while (current != IDX_NIL) {
+        next = pool->next[current];
+        pool->next[current] = prev;
+        prev = current;
+        current = next;
+    }
+    return prev;
+}
+
+// Detect cycle (Floyd's cycle detection) - O(n)
+bool idxHasCycle(const IdxPool* pool, Idx head) {
+    Idx slow = head, fast = head;
+    while (fast != IDX_NIL && pool->next[fast] != IDX_NIL) {
+        slow = pool->next[slow];
+        fast = pool->next[pool->next[fast]];
+        if (slow == fast) return true;
+    }
+    return false;
+}
+
+// Merge two sorted lists of the same pool - O(n+m)
+Idx idxMergeSorted(IdxPool* pool, Idx l1, Idx l2) {
+    Idx head = IDX_NIL, tail = IDX_NIL;
+
+    while (l1 != IDX_NIL && l2 != IDX_NIL) {
+        Idx take;
+        if (pool->data[l1] <= pool->data[l2]) {
+            take = l1;
+            l1 = pool->next[l1];
+        } else {
+            take = l2;
+            l2 = pool->next[l2];
+        }
+        if (tail == IDX_NIL) head = take;
+        else pool->next[tail] = take;
+        tail = take;
+    }
+    Idx rest = (l1 != IDX_NIL) ? l1 : l2;
+    if (tail == IDX_NIL) return rest;
+    pool->next[tail] = rest;
+    return head;
+}
+
+// Reverse in groups of k - O(n), iterative
+Idx idxReverseK(IdxPool* pool, Idx head, int k) {
+    if (head == IDX_NIL || k <= 1) return head;
+
+    Idx newHead = IDX_NIL, prevTail = IDX_NIL, current = head;
+    while (current != IDX_NIL) {
+        Idx groupTail = current, prev = IDX_NIL;
+        for (int count = 0; current != IDX_NIL && count < k; count++) {
+            Idx next = pool->next[current];
+            pool->next[current] = prev;
+            prev = current;
+            current = next;
+        }
+        if (prevTail == IDX_NIL) newHead = prev;
+        else pool->next[prevTail] = prev;
+        prevTail = groupTail;
+    }
+    return newHead;
+}
+
+// Reorder list (L0→Ln→L1→Ln-1→...) - O(n)
+void idxReorderList(IdxPool* pool, Idx head) {
+    if (head == IDX_NIL || pool->next[head] == IDX_NIL) return;
+
+    // Find middle; the first half keeps the extra node when n is odd
+    Idx slow = head, fast = head;
+    while (pool->next[fast] != IDX_NIL && pool->next[pool->next[fast]] != IDX_NIL) {
+        fast = pool->next[pool->next[fast]];
+        slow = pool->next[slow];
+    }
+    Idx second = pool->next[slow];
+    pool->next[slow] = IDX_NIL;
+
+    // Reverse second half, then merge alternately
+    Idx l1 = head, l2 = idxReverse(pool, second);
+    while (l1 != IDX_NIL && l2 != IDX_NIL) {
+        Idx l1Next = pool->next[l1], l2Next = pool->next[l2];
+        pool->next[l1] = l2;
+        pool->next[l2] = l1Next;
+        l1 = l1Next;
+        l2 = l2Next;
+    }
+}
+
+// Utility functions
+void printIdxList(const IdxPool* pool, Idx head) {
+    for (; head != IDX_NIL; head = pool->next[head]) {
+        outInt(pool->data[head]);
+        outStr(" -> ");
+    }
+    outStr("NULL\n");
+    outFlush();
+}
+
+uint32_t idxLength(const IdxPool* pool, Idx head) {
+    uint32_t count = 0;
+    for (; head != IDX_NIL; head = pool->next[head]) count++;
+    return count;
+}
@@ -0,0 +1,277 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// --- Generic Sorting (C++) ---
+// Header-only templates over the same algorithms as basics.c: introSort,
+// bottom-up mergeSort, heapSort and LSD radixSort. The comparator or key
+// extractor is a template parameter, so it inlines. argsort() sorts indices
+// instead of moving large records, and float/double keys radix-sort through
+// the usual bit flip. The int overloads at the bottom keep the basics.c
+// signatures for C++ callers.
+
+namespace sorts {
+
+// Insertion Sort
+template <class T, class Less>
+void insertionSort(T* a, long n, Less less) {
+    for (long i = 1; i < n; i++) {
+        T key = std::move(a[i]);
+        long j = i - 1;
+        while (j >= 0 && less(key, a[j])) {
+            a[j + 1] = std::move(a[j]);
+            j--;
+        }
+        a[j + 1] = std::move(key);
+    }
+}
+
+// Heap Sort
+// 4-ary heap with Floyd's bottom-up sift, as in basics.c.
+template <class T, class Less>
+void heapSiftHole(T* a, long n, long i, T x, Less less) {
+    long hole = i, c;
+    while ((c = 4 * hole + 1) < n) {
+        long m = c, end = c + 4 < n ? c + 4 : n;
+        for (long k = c + 1; k < end; k++)
+            if (less(a[m], a[k])) m = k;
+        a[hole] = std::move(a[m]);
+        hole = m;
+    }
+    while (hole > i) {
+        long p = (hole - 1) / 4;
+        if (!less(a[p], x)) break;
+        a[hole] = std::move(a[p]);
+        hole = p;
+    }
+    a[hole] = std::move(x);
+}
+
+template <class T, class Less>
+void heapify(T* a, long n, long i, Less less) {
+    heapSiftHole(a, n, i, std::move(a[i]), less);
+}
+
+template <class T, class Less = std::less<T>>
+void heapSort(T* a, long n, Less less = Less()) {
+    for (long i = (n - 2) / 4; n > 1 && i >= 0; i--) heapify(a, n, i, less);
+    while (--n > 0) {
+        T x = std::move(a[n]);
+        a[n] = std::move(a[0]);
+        heapSiftHole(a, n, 0, std::move(x), less);
+    }
+}
+
+// Intro Sort
+// Same shape as basics.c: ninther pivot moved to a[h], block partition,
+// recursion on the smaller side, heapSort when the depth budget runs out.
+template <class T, class Less>
+long medianOf3(T* a, long i, long j, long k, Less less) {
+    if (less(a[i], a[j]))
+        return less(a[j], a[k]) ? j : (less(a[i], a[k]) ? k : i);
+    return less(a[i], a[k]) ? i : (less(a[j], a[k]) ? k : j);
+}
+
+template <class T, class Less>
+long partition(T* a, long l, long h, Less less) {
+    constexpr int B = 128;
+    const T& p = a[h];
+    T *first = a + l, *last = a + h - 1;
+    unsigned char offL[B], offR[B];
+    int startL = 0, numL = 0, startR = 0, numR = 0;
+    while (last - first + 1 >= 2 * B) {
+        if (numL == 0) {
+            startL = 0;
+            for (int i = 0; i < B; i++) {
+                offL[numL] = (unsigned char)i;
+                numL += !less(first[i], p);
+            }
+        }
+        if (numR == 0) {
+            startR = 0;
+            for (int i = 0; i < B; i++) {
+                offR[numR] = (unsigned char)i;
+                numR += less(*(last - i), p);
+            }
+        }
+        int num = numL < numR ? numL : numR;
+        for (int k = 0; k < num; k++)
+            std::swap(first[offL[startL + k]], *(last - offR[startR + k]));
+        numL -= num; numR -= num;
+        startL += num; startR += num;
+        if (numL == 0) first += B;
+        if (numR == 0) last -= B;
+    }
+    T* i = first - 1;
+    for (T* j = first; j <= last; j++)
+        if (less(*j, p)) std::swap(*++i, *j);
+    std::swap(i[1], a[h]);
+    return (long)(i + 1 - a);
+}
+
+template <class T, class Less>
+void introSortLoop(T* a, long l, long h, int depth, Less less) {
+    while (h - l + 1 > 16) {
+        if (depth-- == 0) {
+            heapSort(a + l, h - l + 1, less);
+            return;
+        }
+        long m = l + (h - l) / 2, s = (h - l) / 8;
+        long piv = (h - l < 128) ? medianOf3(a, l, m, h, less)
+                 : medianOf3(a, medianOf3(a, l, l + s, l + 2 * s, less),
+                                medianOf3(a, m - s, m, m + s, less),
+                                medianOf3(a, h - 2 * s, h - s, h, less), less);
+        std::swap(a[piv], a[h]);
+        long p = partition(a, l, h, less);
+        if (p - l < h - p) {
+            introSortLoop(a, l, p - 1, depth, less);
+            l = p + 1;
+        } else {
+            introSortLoop(a, p + 1, h, depth, less);
+            h = p - 1;
+        }
+    }
+    if (l < h) insertionSort(a + l, h - l + 1, less);
+}
+
+template <class T, class Less = std::less<T>>
+void introSort(T* a, long l, long h, Less less = Less()) {
+    int depth = 0;
+    for (long n = h - l + 1; n > 1; n >>= 1) depth += 2;
+    introSortLoop(a, l, h, depth, less);
+}
+
+// Bottom-up Merge Sort (stable), one n-sized buffer, ping-pong passes.
+// Records are moved, never copied, so T may be move-only; it must be
+// default-constructible when no buffer is passed.
+template <class T, class Less = std::less<T>>
+void mergeSort(T* a, long n, Less less = Less(), T* buf = nullptr) {
+    if (n < 2) return;
+    std::vector<T> own;
+    if (!buf) {
+        own.resize(n);
+        buf = own.data();
+    }
+    constexpr long RUN = 32;
+    for (long i = 0; i < n; i += RUN) insertionSort(a + i, n - i < RUN ? n - i : RUN, less);
+    T *src = a, *dst = buf;
+    for (long w = RUN; w < n; w *= 2) {
+        for (long l = 0; l < n; l += 2 * w) {
+            long m = l + w < n ? l + w : n, r = m + w < n ? m + w : n;
+            long i = l, j = m, k = l;
+            if (m < r && less(src[m], src[m - 1])) {
+                while (i < m && j < r)
+                    dst[k++] = less(src[j], src[i]) ? std::move(src[j++]) : std::move(src[i++]);
+            }
+            k = std::move(src + i, src + m, dst + k) - dst;
+            std::move(src + j, src + r, dst + k);
+        }
+        std::swap(src, dst);
+    }
+    if (src != a) std::move(src, src + n, a);
+}
+
+// Radix Sort
+// RadixKey<K>::bits() maps a key to an unsigned integer of the same width
+// whose unsigned order matches the key order: signed ints flip the sign bit,
+// floats flip every bit when negative and only the sign bit otherwise.
+template <class K, class Enable = void>
+struct RadixKey;
+
+template <class K>
+struct RadixKey<K, typename std::enable_if<std::is_integral<K>::value>::type> {
+    using U = typename std::make_unsigned<K>::type;
+    static U bits(K k) {
+        return std::is_signed<K>::value ? (U)k ^ ((U)1 << (8 * sizeof(K) - 1)) : (U)k;
+    }
+};
+
+template <class K>
+struct RadixKey<K, typename std::enable_if<std::is_floating_point<K>::value>::type> {
+    using U = typename std::conditional<sizeof(K) == 4, uint32_t, uint64_t>::type;
+    static U bits(K k) {
+        U u;
+        std::memcpy(&u, &k, sizeof(u));
+        const U sign = (U)1 << (8 * sizeof(U) - 1);
+        return (u & sign) ? ~u : (u | sign);
+    }
+};
+
+// Stable LSD sort of records by key(record), 8-bit digits. Passes whose
+// digit is identical for every record are skipped. T must be movable and
+// default-constructible when no buffer is passed.
+template <class T, class KeyFn>
+void radixSort(T* a, long n, KeyFn key, T* buf = nullptr) {
+    using K = typename std::decay<decltype(key(a[0]))>::type;
+    using U = typename RadixKey<K>::U;
+    constexpr int PASSES = sizeof(U);
+    if (n < 2) return;
+    std::vector<T> own;
+    if (!buf) {
+        own.resize(n);
+        buf = own.data();
+    }
+    std::vector<long> cnt(PASSES * 256);
+    for (long i = 0; i < n; i++) {
+        U k = RadixKey<K>::bits(key(a[i]));
+        for (int p = 0; p < PASSES; p++) cnt[p * 256 + ((k >> (8 * p)) & 255)]++;
+    }
+    T *src = a, *dst = buf;
+    for (int p = 0; p < PASSES; p++) {
+        long* c = &cnt[p * 256];
+        if (c[(RadixKey<K>::bits(key(src[0])) >> (8 * p)) & 255] == n) continue;
+        long sum = 0;
+        for (int d = 0; d < 256; d++) {
+            long t = c[d];
+            c[d] = sum;
+            sum += t;
+        }
+        for (long i = 0; i < n; i++)
+            dst[c[(RadixKey<K>::bits(key(src[i])) >> (8 * p)) & 255]++] = std::move(src[i]);
+        std::swap(src, dst);
+    }
+    if (src != a)
+        for (long i = 0; i < n; i++) a[i] = std::move(src[i]);
+}
+
+// Arg Sort
+// Index permutations for records too large to move around: sort
+// a[idx[0]], a[idx[1]], ... instead of a itself.
+template <class T, class Less = std::less<T>>
+std::vector<uint32_t> argsort(const T* a, long n, Less less = Less()) {
+    std::vector<uint32_t> idx(n);
+    for (long i = 0; i < n; i++) idx[i] = (uint32_t)i;
+    mergeSort(idx.data(), n, [&](uint32_t i, uint32_t j) { return less(a[i], a[j]); });
+    return idx;
+}
+
+// Keys are extracted once into (key bits, index) pairs, so the radix passes
+// stream over a compact array rather than the records.
+template <class T, class KeyFn>
+std::vector<uint32_t> argsortByKey(const T* a, long n, KeyFn key) {
+    using K = typename std::decay<decltype(key(a[0]))>::type;
+    using U = typename RadixKey<K>::U;
+    struct Item {
+        U k;
+        uint32_t i;
+    };
+    std::vector<Item> items(n);
+    for (long i = 0; i < n; i++) items[i] = {RadixKey<K>::bits(key(a[i])), (uint32_t)i};
+    radixSort(items.data(), n, [](const Item& t) { return t.k; });
+    std::vector<uint32_t> idx(n);
+    for (long i = 0; i < n; i++) idx[i] = items[i].i;
+    return idx;
+}
+
+// int entry points with the basics.c signatures.
+inline void introSort(int arr[], int l, int h) { introSort<int, std::less<int>>(arr, l, h); }
+inline void heapSort(int arr[], int n) { heapSort<int, std::less<int>>(arr, n); }
+inline void mergeSortBottomUp(int arr[], int n, int buf[]) { mergeSort(arr, n, std::less<int>(), buf); }
+inline void radixSort(int arr[], int n) { radixSort(arr, (long)n, [](int x) { return x; }); }
+
+} // namespace sorts
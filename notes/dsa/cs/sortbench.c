@@ -0,0 +1,273 @@
+#define SORT_STATS
+#include "basics.c"
+#include <math.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+// --- Sorting Benchmark ---
+// Runs every sort in basics.c over several input distributions and sizes,
+// with warmup and repetitions, and prints one CSV (default) or JSON row per
+// run: median ns/element, comparisons and swaps per sort call, and, when
+// perf_event_open is allowed, cycles/instructions/branch-misses per element
+// (-1 in CSV and omitted in JSON when it is not). Comparisons and swaps are
+// reported the same way for sorts whose counters do not cover every step
+// (timSort, the bottom-up merge, radix and the sortAuto dispatcher).
+// O(n^2) sorts, and quickSort on anything but uniform keys, are capped at
+// small n; mergeSort is capped where its stack VLAs would overflow.
+// sampleSort runs on every online CPU; few_unique and zipf are its skewed
+// cases, where one key fills many splitters.
+//
+// Build: gcc -O2 -pthread sortbench.c -o sortbench -lm
+// Usage: sortbench [--json] [--max N] [--reps R]
+
+typedef enum { UNIFORM, SORTED, REVERSE, NEARLY, FEW_UNIQUE, ORGAN_PIPE, ZIPF, DIST_COUNT } Dist;
+
+static const char *distNames[DIST_COUNT] = {
+    "uniform", "sorted", "reverse", "nearly_sorted", "few_unique", "organ_pipe", "zipf"
+};
+
+typedef struct {
+    const char *name;
+    void (*fn)(int[], int);
+    int maxN;       // largest n for uniform keys
+    int maxNOther;  // largest n for every other distribution
+    int counted;    // SORT_STATS counters cover the whole sort
+} Algo;
+
+static void runMergeSort(int arr[], int n) { if (n > 0) mergeSort(arr, 0, n - 1); }
+static void runQuickSort(int arr[], int n) { if (n > 0) quickSort(arr, 0, n - 1); }
+static void runIntroSort(int arr[], int n) { if (n > 0) introSort(arr, 0, n - 1); }
+static void runQuickSort3Way(int arr[], int n) { if (n > 0) quickSort3Way(arr, 0, n - 1); }
+static void runMergeSortBottomUp(int arr[], int n) { mergeSortBottomUp(arr, n, NULL); }
+static void runSampleSort(int arr[], int n) { sampleSort(arr, n, (int)sysconf(_SC_NPROCESSORS_ONLN), NULL); }
+
+static const Algo algos[] = {
+    {"bubbleSort", bubbleSort, 1 << 14, 1 << 14, 1},
+    {"selectionSort", selectionSort, 1 << 14, 1 << 14, 1},
+    {"insertionSort", insertionSort, 1 << 14, 1 << 14, 1},
+    {"mergeSort", runMergeSort, 1 << 20, 1 << 20, 1},
+    {"quickSort", runQuickSort, INT_MAX, 1 << 14, 1},
+    {"heapSort", heapSort, INT_MAX, INT_MAX, 1},
+    {"introSort", runIntroSort, INT_MAX, INT_MAX, 1},
+    {"quickSort3Way", runQuickSort3Way, INT_MAX, INT_MAX, 1},
+    {"mergeSortBottomUp", runMergeSortBottomUp, INT_MAX, INT_MAX, 0},
+    {"timSort", timSort, INT_MAX, INT_MAX, 0},
+    {"radixSort", radixSort, INT_MAX, INT_MAX, 0},
+    {"sortAuto", sortAuto, INT_MAX, INT_MAX, 0},
+    {"sampleSort", runSampleSort, INT_MAX, INT_MAX, 0},
+};
+
+static unsigned long long rngState = 88172645463325252ull;
+
+static unsigned long long rng(void) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 7;
+    rngState ^= rngState << 17;
+    return rngState;
+}
+
+// Returns 0, or -1 when the Zipf table cannot be allocated.
+static int generate(int arr[], int n, Dist d) {
+    switch (d) {
+    case UNIFORM:
+        for (int i = 0; i < n; i++) arr[i] = (int)rng();
+        break;
+    case SORTED:
+    case REVERSE:
+    case NEARLY:
+        for (int i = 0; i < n; i++) arr[i] = (d == REVERSE) ? n - i : i;
+        if (d == NEARLY)
+            for (int s = 0; s < n / 100 + 1; s++) {
+                int a = rng() % n, b = rng() % n;
+                int t = arr[a]; arr[a] = arr[b]; arr[b] = t;
+            }
+        break;
+    case FEW_UNIQUE:
+        for (int i = 0; i < n; i++) arr[i] = rng() % 16;
+        break;
+    case ORGAN_PIPE:
+        for (int i = 0; i < n; i++) arr[i] = (i < n / 2) ? i : n - i;
+        break;
+    case ZIPF: {
+        // Inverse CDF over up to 64K ranks with exponent 1.
+        int ranks = n < (1 << 16) ? n : (1 << 16);
+        double *cdf = (double*)malloc(ranks * sizeof(double)), sum = 0;
+        if (!cdf) return -1;
+        for (int r = 0; r < ranks; r++) cdf[r] = (sum += 1.0 / (r + 1));
+        for (int i = 0; i < n; i++) {
+            double u = (rng() >> 11) * (1.0 / 9007199254740992.0) * sum;
+            int lo = 0, hi = ranks - 1;
+            while (lo < hi) {
+                int mid = (lo + hi) / 2;
+                if (cdf[mid] < u) lo = mid + 1;
+                else hi = mid;
+            }
+            arr[i] = lo;
+        }
+        free(cdf);
+        break;
+    }
+    default:
+        break;
+    }
+    return 0;
+}
+
+// Hardware counters: one group (cycles, instructions, branch-misses) whose
+// fds go in perfFds; returns the leader, or -1.
+static int perfFds[3] = {-1, -1, -1};
+
+static void perfClose(void) {
+    for (int i = 0; i < 3; i++) {
+        if (perfFds[i] >= 0) close(perfFds[i]);
+        perfFds[i] = -1;
+    }
+}
+
+static int perfOpen(void) {
+    unsigned long long configs[3] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                     PERF_COUNT_HW_BRANCH_MISSES};
+    int leader = -1;
+    for (int i = 0; i < 3; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.disabled = (i == 0);
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        int fd = syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+        if (fd < 0) {
+            perfClose();
+            return -1;
+        }
+        perfFds[i] = fd;
+        if (i == 0) leader = fd;
+    }
+    return leader;
+}
+
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int cmpDouble(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char *argv[]) {
+    int json = 0, reps = 5;
+    long maxN = 1 << 20;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--json")) json = 1;
+        else if (!strcmp(argv[i], "--max") && i + 1 < argc) maxN = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--reps") && i + 1 < argc) reps = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--json] [--max N] [--reps R]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (maxN < 16) {  // sizes start at 16, and batch divides by n
+        fprintf(stderr, "usage: %s [--json] [--max N] [--reps R]  (N >= 16)\n", argv[0]);
+        return 2;
+    }
+    if (reps < 1) reps = 1;
+    if (maxN > 100000000) maxN = 100000000;
+
+    // Sizes 16, 256, 4K, ... up to maxN, then maxN itself.
+    int sizes[16], nsizes = 0;
+    for (long n = 16; n < maxN && nsizes < 15; n *= 16) sizes[nsizes++] = (int)n;
+    sizes[nsizes++] = (int)maxN;
+
+    // Small n is timed in batches so every sample covers at least 64K elements.
+    long bufLen = maxN > (1 << 16) ? maxN : (1 << 16);
+    int *input = (int*)malloc(bufLen * sizeof(int));
+    int *work = (int*)malloc(bufLen * sizeof(int));
+    double *samples = (double*)malloc(reps * sizeof(double));
+    if (!input || !work || !samples) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    int perf = perfOpen();
+
+    if (json) printf("[\n");
+    else printf("algorithm,distribution,n,ns_per_element,comparisons,swaps,"
+                "cycles_per_element,instructions_per_element,branch_misses_per_element\n");
+    int first = 1;
+    for (int s = 0; s < nsizes; s++) {
+        int n = sizes[s], batch = n < (1 << 16) ? (1 << 16) / n : 1;
+        for (int d = 0; d < DIST_COUNT; d++) {
+            for (int b = 0; b < batch; b++)
+                if (generate(input + (long)b * n, n, (Dist)d) < 0) {
+                    fprintf(stderr, "out of memory\n");
+                    return 1;
+                }
+            for (size_t a = 0; a < sizeof(algos) / sizeof(algos[0]); a++) {
+                const Algo *algo = &algos[a];
+                if (n > (d == UNIFORM ? algo->maxN : algo->maxNOther)) continue;
+
+                long long cmps = 0, swaps = 0;
+                unsigned long long hw[4] = {0}, total[3] = {0};
+                for (int r = -1; r < reps; r++) {  // r == -1 is the warmup
+                    memcpy(work, input, (long)batch * n * sizeof(int));
+                    sortCmps = sortSwaps = 0;
+                    if (perf >= 0 && r >= 0) {
+                        ioctl(perf, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                        ioctl(perf, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+                    }
+                    double t = nowNs();
+                    for (int b = 0; b < batch; b++) algo->fn(work + (long)b * n, n);
+                    t = nowNs() - t;
+                    if (perf >= 0 && r >= 0) {
+                        ioctl(perf, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+                        if (read(perf, hw, sizeof(hw)) == sizeof(hw))
+                            for (int k = 0; k < 3; k++) total[k] += hw[k + 1];
+                    }
+                    if (r < 0) continue;
+                    samples[r] = t / ((double)batch * n);
+                    cmps += sortCmps;
+                    swaps += sortSwaps;
+                }
+                for (long i = 1; i < (long)batch * n; i++)
+                    if (i % n && work[i - 1] > work[i]) {
+                        fprintf(stderr, "%s: %s n=%d not sorted\n", algo->name, distNames[d], n);
+                        break;
+                    }
+
+                qsort(samples, reps, sizeof(double), cmpDouble);
+                double elems = (double)reps * batch * n, calls = (double)reps * batch;
+                double hwPer[3];
+                for (int k = 0; k < 3; k++) hwPer[k] = perf >= 0 ? total[k] / elems : -1;
+                double cmpsPer = algo->counted ? cmps / calls : -1;
+                double swapsPer = algo->counted ? swaps / calls : -1;
+                if (json) {
+                    printf("%s  {\"algorithm\": \"%s\", \"distribution\": \"%s\", \"n\": %d, "
+                           "\"ns_per_element\": %.3f",
+                           first ? "" : ",\n", algo->name, distNames[d], n, samples[reps / 2]);
+                    if (algo->counted)
+                        printf(", \"comparisons\": %.0f, \"swaps\": %.0f", cmpsPer, swapsPer);
+                    if (perf >= 0)
+                        printf(", \"cycles_per_element\": %.3f, \"instructions_per_element\": %.3f, "
+                               "\"branch_misses_per_element\": %.4f", hwPer[0], hwPer[1], hwPer[2]);
+                    printf("}");
+                } else {
+                    printf("%s,%s,%d,%.3f,%.0f,%.0f,%.3f,%.3f,%.4f\n", algo->name, distNames[d], n,
+                           samples[reps / 2], cmpsPer, swapsPer, hwPer[0], hwPer[1], hwPer[2]);
+                }
+                first = 0;
+                fflush(stdout);
+            }
+        }
+    }
+    if (json) printf("\n]\n");
+    perfClose();
+    free(input); free(work); free(samples);
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include "basics.c"
+
+// --- sortAuto Dispatch Test ---
+// Feeds sortAutoProfile() inputs built to hit each dispatch rule and checks
+// both the algorithm it picked and that the result is sorted. Then times
+// timSort against mergeSort on random input, where timSort has no runs to
+// exploit and must still be no slower (best of RACE_REPS, RACE_SLACK for
+// timer noise). Prints one line per case and exits non-zero if any fails.
+//
+// Build: gcc -O2 -pthread sorttest.c -o sorttest -lm
+// Usage: sorttest
+
+typedef enum { ASCENDING, RANDOM, NARROW, RUNS, FEW_WIDE } Shape;
+
+typedef struct {
+    const char *name;
+    Shape shape;
+    int n;
+    const char *expect;
+} Case;
+
+static const Case cases[] = {
+    {"sorted", ASCENDING, 1000, "none"},
+    {"small", RANDOM, 20, "sortSmall"},
+    {"narrow range", NARROW, 5000, "countingSort"},
+    {"few long runs", RUNS, 5000, "timSort"},
+    {"large random", RANDOM, 100000, "radixSort"},
+    {"few wide keys, n = 100", FEW_WIDE, 100, "quickSort3Way"},
+    {"few wide keys, n = 500", FEW_WIDE, 500, "quickSort3Way"},
+    {"few wide keys, large", FEW_WIDE, 100000, "radixSort"},
+    {"random, n = 300", RANDOM, 300, "introSort"},
+};
+
+#define RACE_N (1 << 20)
+#define RACE_REPS 9
+#define RACE_SLACK 1.05
+
+static unsigned rngState = 2463534242u;
+
+static unsigned rng(void) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static void generate(int arr[], int n, Shape shape) {
+    int keys[8];
+    for (int i = 0; i < 8; i++) keys[i] = (int)rng();
+    for (int i = 0; i < n; i++) {
+        switch (shape) {
+        case ASCENDING: arr[i] = i; break;
+        case RANDOM: arr[i] = (int)rng(); break;
+        case NARROW: arr[i] = 1000000 + rng() % (n / 2); break;
+        case RUNS: arr[i] = (i % (n / 4)) * 1000; break;  // four ascending runs
+        case FEW_WIDE: arr[i] = keys[rng() % 8]; break;
+        }
+    }
+}
+
+// Best time of timSort and of mergeSort over the same random input; the
+// two are interleaved so that drift in machine load hits both alike.
+static int raceTimSort(void) {
+    int *src = (int*)malloc(RACE_N * sizeof(int)), *arr = (int*)malloc(RACE_N * sizeof(int));
+    if (!src || !arr) {
+        fprintf(stderr, "out of memory\n");
+        free(src);
+        free(arr);
+        return 0;
+    }
+    generate(src, RACE_N, RANDOM);
+    double best[2] = {1e30, 1e30};
+    int sorted = 1;
+    for (int rep = 0; rep < RACE_REPS; rep++) {
+        for (int s = 0; s < 2; s++) {
+            memcpy(arr, src, RACE_N * sizeof(int));
+            double t = nowMs();
+            if (s == 0) timSort(arr, RACE_N);
+            else mergeSort(arr, 0, RACE_N - 1);
+            t = nowMs() - t;
+            if (t < best[s]) best[s] = t;
+            for (int i = 1; i < RACE_N; i++)
+                if (arr[i - 1] > arr[i]) sorted = 0;
+        }
+    }
+    int ok = sorted && best[0] <= best[1] * RACE_SLACK;
+    printf("%s  %-24s n=%-7d timSort %.1f ms, mergeSort %.1f ms%s\n", ok ? "PASS" : "FAIL",
+           "timSort vs mergeSort", RACE_N, best[0], best[1], sorted ? "" : ", not sorted");
+    free(src);
+    free(arr);
+    return ok;
+}
+
+int main(void) {
+    int failed = 0;
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        const Case *tc = &cases[c];
+        int *arr = (int*)malloc(tc->n * sizeof(int));
+        if (!arr) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+        generate(arr, tc->n, tc->shape);
+        SortAutoStats st;
+        sortAutoProfile(arr, tc->n, &st);
+
+        int sorted = 1;
+        for (int i = 1; i < tc->n; i++)
+            if (arr[i - 1] > arr[i]) sorted = 0;
+        int ok = sorted && !strcmp(st.algorithm, tc->expect);
+        printf("%s  %-24s n=%-7d dupPairs=%-3d -> %s (expected %s)%s\n", ok ? "PASS" : "FAIL",
+               tc->name, tc->n, st.dupPairs, st.algorithm, tc->expect, sorted ? "" : ", not sorted");
+        failed += !ok;
+        free(arr);
+    }
+    failed += !raceTimSort();
+    return failed != 0;
+}
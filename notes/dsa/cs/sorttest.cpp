@@ -0,0 +1,81 @@
+#include "sort.hpp"
+#include <cstdio>
+#include <memory>
+
+// --- sort.hpp Move-only Test ---
+// Sorts records that own a std::unique_ptr payload with every template in
+// sort.hpp, so a template that copies a record instead of moving it fails
+// to compile here. Each run checks that the keys come out in order, that
+// the stable sorts keep equal keys in input order, and that every payload
+// still holds its record's value (a record left moved-from shows up as a
+// null payload). Prints one line per sort and exits non-zero if any fails.
+//
+// Build: g++ -O2 -std=c++17 sorttest.cpp -o sorttest-hpp
+// Usage: sorttest-hpp
+
+struct Record {
+    int key = 0;
+    long seq = 0;  // input position, for the stability check
+    std::unique_ptr<long> payload;
+
+    Record() = default;
+    Record(Record&&) = default;
+    Record& operator=(Record&&) = default;
+    Record(const Record&) = delete;
+    Record& operator=(const Record&) = delete;
+};
+
+static const long N = 100000;
+
+static std::vector<Record> makeRecords() {
+    std::vector<Record> v(N);
+    unsigned s = 2463534242u;
+    for (long i = 0; i < N; i++) {
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+        v[i].key = (int)(s % 1000) - 500;  // many equal keys
+        v[i].seq = i;
+        v[i].payload.reset(new long(i));
+    }
+    return v;
+}
+
+static bool check(const char* name, const std::vector<Record>& v, bool stable) {
+    bool ok = true;
+    for (long i = 0; i < N && ok; i++) {
+        if (!v[i].payload || *v[i].payload != v[i].seq) ok = false;
+        if (i > 0 && v[i - 1].key > v[i].key) ok = false;
+        if (i > 0 && stable && v[i - 1].key == v[i].key && v[i - 1].seq > v[i].seq) ok = false;
+    }
+    std::printf("%s  %-26s n=%ld%s\n", ok ? "PASS" : "FAIL", name, N, stable ? ", stable" : "");
+    return ok;
+}
+
+int main() {
+    auto byKey = [](const Record& a, const Record& b) { return a.key < b.key; };
+    int failed = 0;
+
+    std::vector<Record> v = makeRecords();
+    sorts::mergeSort(v.data(), N, byKey);
+    failed += !check("mergeSort", v, true);
+
+    v = makeRecords();
+    std::vector<Record> buf(N);
+    sorts::mergeSort(v.data(), N, byKey, buf.data());
+    failed += !check("mergeSort, caller buffer", v, true);
+
+    v = makeRecords();
+    sorts::radixSort(v.data(), N, [](const Record& r) { return r.key; });
+    failed += !check("radixSort", v, true);
+
+    v = makeRecords();
+    sorts::introSort(v.data(), 0, N - 1, byKey);
+    failed += !check("introSort", v, false);
+
+    v = makeRecords();
+    sorts::heapSort(v.data(), N, byKey);
+    failed += !check("heapSort", v, false);
+
+    return failed != 0;
+}
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include "out.h"
 
 // -- Stacks --
 typedef struct {
@@ -223,13 +224,20 @@ void nextGreaterElement(int *arr, int n) {
     Stack *s = createStack(100);
     for (int i = 0; i < n; i++) {
         while (!isEmpty(s) && arr[i] > arr[peek(s)]) {
-            printf("%d -> %d\n", pop(s), arr[i]);
+            outInt(pop(s));
+            outStr(" -> ");
+            outInt(arr[i]);
+            outStr("\n");
         }
         push(s, i);
     }
     while (!isEmpty(s)) {
-        printf("%d -> -1\n", pop(s));
+        outInt(pop(s));
+        outStr(" -> ");
+        outInt(-1);
+        outStr("\n");
     }
+    outFlush();
 }
 
 // Next Greater Element (Circular)
@@ -237,11 +245,18 @@ void nextGreaterElementCircular(int *arr, int n) {
     Stack *s = createStack(100);
     for (int i = 0; i < 2 * n; i++) {
         while (!isEmpty(s) && arr[i % n] > arr[peek(s)]) {
-            printf("%d -> %d\n", pop(s), arr[i % n]);
+            outInt(pop(s));
+            outStr(" -> ");
+            outInt(arr[i % n]);
+            outStr("\n");
         }
         if (i < n) push(s, i % n);
     }
     while (!isEmpty(s)) {
-        printf("%d -> -1\n", pop(s));
+        outInt(pop(s));
+        outStr(" -> ");
+        outInt(-1);
+        outStr("\n");
     }
+    outFlush();
 }
\ No newline at end of file